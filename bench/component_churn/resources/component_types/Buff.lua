@@ -0,0 +1,6 @@
+Buff = {
+	stacks = 1,
+
+	OnUpdate = function(self)
+	end
+}
@@ -0,0 +1,66 @@
+-- Adds a Buff to every Unit on one frame, removes them all on the next, then idles a frame.
+-- Each frame's cost is measured from this OnUpdate to the next one, so it includes the Lua
+-- calls and the end-of-frame batches that actually insert and erase the components.
+ComponentChurnBench = {
+	unit_count = 10000,
+	cycles = 50,
+
+	OnStart = function(self)
+		self.units = Actor.InstantiateMany("Unit", self.unit_count)
+		self.buffs = {}
+		self.cycle = 0
+		self.phase = "warmup"
+		self.totals = { add = 0, remove = 0, idle = 0, add_calls = 0, remove_calls = 0 }
+		self.last_clock = os.clock()
+	end,
+
+	OnUpdate = function(self)
+		local now = os.clock()
+		if self.totals[self.phase] ~= nil then
+			self.totals[self.phase] = self.totals[self.phase] + (now - self.last_clock)
+		end
+
+		if self.phase == "idle" or self.phase == "warmup" then
+			if self.cycle == self.cycles then
+				self:Report()
+				Application.Quit()
+			end
+			self.cycle = self.cycle + 1
+
+			local calls_start = os.clock()
+			for i = 1, #self.units do
+				self.buffs[i] = self.units[i]:AddComponent("Buff")
+			end
+			self.totals.add_calls = self.totals.add_calls + (os.clock() - calls_start)
+			self.phase = "add"
+		elseif self.phase == "add" then
+			local calls_start = os.clock()
+			for i = 1, #self.units do
+				self.units[i]:RemoveComponent(self.buffs[i])
+			end
+			self.totals.remove_calls = self.totals.remove_calls + (os.clock() - calls_start)
+			self.phase = "remove"
+		else
+			self.phase = "idle"
+		end
+
+		self.last_clock = now
+	end,
+
+	Report = function(self)
+		local function ms(total) return total * 1000 / self.cycles end
+		local idle = ms(self.totals.idle)
+		print(string.format("%d units, %d cycles", self.unit_count, self.cycles))
+		print(string.format("idle   frame: %.2f ms", idle))
+		self:ReportPhase("add", idle)
+		self:ReportPhase("remove", idle)
+	end,
+
+	-- The Lua calls only queue the change, the rest of the frame over idle is the engine applying it
+	ReportPhase = function(self, phase, idle)
+		local function ms(total) return total * 1000 / self.cycles end
+		local frame = ms(self.totals[phase])
+		local calls = ms(self.totals[phase .. "_calls"])
+		print(string.format("%-6s frame: %.2f ms (calls %.2f ms, applying %.2f ms)", phase, frame, calls, frame - idle - calls))
+	end
+}
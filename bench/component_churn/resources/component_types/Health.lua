@@ -0,0 +1,3 @@
+Health = {
+	hp = 100
+}
@@ -0,0 +1,6 @@
+Mover = {
+	speed = 1,
+
+	OnUpdate = function(self)
+	end
+}
@@ -0,0 +1,3 @@
+Damage = {
+	amount = 1
+}
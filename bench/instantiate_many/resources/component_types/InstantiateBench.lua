@@ -0,0 +1,66 @@
+-- Spawns 10k Bullets with a loop of Actor.Instantiate or one Actor.InstantiateMany, alternating
+-- between the two each round. Each round times the spawn call, the next frame (which starts the
+-- new actors) and the frame after Actor.Destroy on all of them.
+InstantiateBench = {
+	spawn_count = 10000,
+	rounds = 20,
+
+	OnStart = function(self)
+		self.round = 0
+		self.step = "spawn"
+		self.results = {
+			loop = { spawn = 0, start = 0, destroy = 0 },
+			many = { spawn = 0, start = 0, destroy = 0 }
+		}
+		self.last_clock = os.clock()
+	end,
+
+	OnUpdate = function(self)
+		local now = os.clock()
+		local mode = (self.round % 2 == 0) and "loop" or "many"
+		local results = self.results[mode]
+
+		if self.step == "spawn" then
+			if self.round == self.rounds * 2 then
+				self:Report()
+				Application.Quit()
+			end
+
+			local spawn_start = os.clock()
+			if mode == "loop" then
+				self.spawned = {}
+				for i = 1, self.spawn_count do
+					self.spawned[i] = Actor.Instantiate("Bullet")
+				end
+			else
+				self.spawned = Actor.InstantiateMany("Bullet", self.spawn_count)
+			end
+			results.spawn = results.spawn + (os.clock() - spawn_start)
+			self.step = "start"
+		elseif self.step == "start" then
+			results.start = results.start + (now - self.last_clock)
+			for i = 1, #self.spawned do
+				Actor.Destroy(self.spawned[i])
+			end
+			self.spawned = nil
+			self.step = "destroy"
+		else
+			results.destroy = results.destroy + (now - self.last_clock)
+			self.round = self.round + 1
+			self.step = "spawn"
+			collectgarbage()
+		end
+
+		self.last_clock = os.clock()
+	end,
+
+	Report = function(self)
+		print(string.format("%d spawns, %d rounds each", self.spawn_count, self.rounds))
+		for _, mode in ipairs({ "loop", "many" }) do
+			local results = self.results[mode]
+			local function ms(total) return total * 1000 / self.rounds end
+			print(string.format("%-4s spawn call %.2f ms, start frame %.2f ms, destroy frame %.2f ms",
+				mode, ms(results.spawn), ms(results.start), ms(results.destroy)))
+		end
+	end
+}
@@ -0,0 +1,6 @@
+Lifetime = {
+	frames = 120,
+
+	OnUpdate = function(self)
+	end
+}
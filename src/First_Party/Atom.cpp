@@ -0,0 +1,87 @@
+#include "Atom.h"
+#include <cstring>
+
+Atom::Atom(const std::string& str) : id(AtomTable::Intern(str.data(), str.size())) {}
+
+Atom::Atom(const char* str) : id(AtomTable::Intern(str, std::strlen(str))) {}
+
+const std::string& Atom::str() const {
+	return AtomTable::GetString(id);
+}
+
+uint32_t AtomTable::Intern(const char* str, size_t length) {
+	if (strings.empty())
+		strings.emplace_back(); // id 0 is the empty string
+
+	if (length == 0)
+		return 0;
+
+	std::string key(str, length);
+
+	auto existing = ids.find(key);
+	if (existing != ids.end())
+		return existing->second;
+
+	uint32_t id = static_cast<uint32_t>(strings.size());
+	strings.emplace_back(key);
+	ids.emplace(std::move(key), id);
+
+	return id;
+}
+
+const std::string& AtomTable::GetString(uint32_t id) {
+	if (strings.empty())
+		strings.emplace_back();
+
+	return strings[id];
+}
+
+Atom AtomTable::FromLua(lua_State* lua_state, int index) {
+	Atom atom;
+
+	if (lua_type(lua_state, index) != LUA_TSTRING) {
+		// Numbers and the like go through the slow path, converting a copy
+		// since lua_tolstring would change the value on the stack
+		lua_pushvalue(lua_state, index);
+		size_t length = 0;
+		const char* str = lua_tolstring(lua_state, -1, &length);
+		if (str != nullptr)
+			atom.id = Intern(str, length);
+		lua_pop(lua_state, 1);
+		return atom;
+	}
+
+	index = lua_absindex(lua_state, index);
+
+	if (lua_cache_ref == LUA_NOREF || lua_cache_size >= LUA_CACHE_LIMIT) {
+		if (lua_cache_ref != LUA_NOREF)
+			luaL_unref(lua_state, LUA_REGISTRYINDEX, lua_cache_ref);
+
+		lua_newtable(lua_state);
+		lua_cache_ref = luaL_ref(lua_state, LUA_REGISTRYINDEX);
+		lua_cache_size = 0;
+	}
+
+	lua_rawgeti(lua_state, LUA_REGISTRYINDEX, lua_cache_ref);
+	lua_pushvalue(lua_state, index);
+	lua_rawget(lua_state, -2);
+
+	if (lua_isinteger(lua_state, -1)) {
+		atom.id = static_cast<uint32_t>(lua_tointeger(lua_state, -1));
+		lua_pop(lua_state, 2);
+		return atom;
+	}
+	lua_pop(lua_state, 1);
+
+	size_t length = 0;
+	const char* str = lua_tolstring(lua_state, index, &length);
+	atom.id = Intern(str, length);
+
+	lua_pushvalue(lua_state, index);
+	lua_pushinteger(lua_state, static_cast<lua_Integer>(atom.id));
+	lua_rawset(lua_state, -3);
+	lua_pop(lua_state, 1);
+	lua_cache_size++;
+
+	return atom;
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+#pragma once
+#ifndef ATOM_H
+#define ATOM_H
+
+#include <deque>
+#include <unordered_map>
+#include "utility.h"
+
+// An interned string. Two atoms are equal exactly when their strings are,
+// so comparing and hashing them is an integer operation.
+class Atom {
+public:
+	uint32_t id = 0; // 0 is the empty string
+
+	Atom() {}
+
+	// Interns str, hashing it once
+	Atom(const std::string& str);
+
+	Atom(const char* str);
+
+	const std::string& str() const;
+
+	bool operator==(const Atom& other) const { return id == other.id; }
+	bool operator!=(const Atom& other) const { return id != other.id; }
+};
+
+namespace std {
+	template <>
+	struct hash<Atom> {
+		size_t operator()(const Atom& atom) const { return atom.id; }
+	};
+}
+
+class AtomTable
+{
+public:
+	static inline ENGINE_THREAD_LOCAL std::unordered_map<std::string, uint32_t> ids;
+
+	// Deque so references handed out by GetString stay valid as the table grows
+	static inline ENGINE_THREAD_LOCAL std::deque<std::string> strings;
+
+	// Public method to access the single instance of the class
+	static AtomTable& getInstance() {
+		static AtomTable instance; // Guaranteed to be created only once
+		return instance;
+	}
+
+	static uint32_t Intern(const char* str, size_t length);
+
+	static const std::string& GetString(uint32_t id);
+
+	// Reads the lua string at index as an atom. Lua strings are already interned and
+	// carry their hash, so the id is cached in a registry table keyed by the string
+	// itself and repeated calls from scripts never hash on the C++ side.
+	static Atom FromLua(lua_State* lua_state, int index);
+
+	// Atom arguments are type, actor, tag and event names, a small set in practice.
+	// The lua cache is dropped and refilled when it passes this many entries, in case a script
+	// builds names on the fly (component keys are plain strings for the same reason).
+	static constexpr int LUA_CACHE_LIMIT = 4096;
+
+private:
+	static inline ENGINE_THREAD_LOCAL int lua_cache_ref = LUA_NOREF;
+	static inline ENGINE_THREAD_LOCAL int lua_cache_size = 0;
+
+	// Private constructor and destructor to prevent multiple instances
+	AtomTable() {}
+	~AtomTable() = default;
+
+	// Delete copy constructor and assignment operator to prevent copying
+	AtomTable(const AtomTable&) = delete;
+	AtomTable& operator=(const AtomTable&) = delete;
+};
+
+namespace luabridge {
+	// Atoms cross into lua as plain strings
+	template <>
+	struct Stack<Atom> {
+		static void push(lua_State* lua_state, const Atom& atom) {
+			const std::string& str = atom.str();
+			lua_pushlstring(lua_state, str.data(), str.size());
+		}
+
+		static Atom get(lua_State* lua_state, int index) {
+			return AtomTable::FromLua(lua_state, index);
+		}
+
+		static bool isInstance(lua_State* lua_state, int index) {
+			return lua_type(lua_state, index) == LUA_TSTRING;
+		}
+	};
+}
+
+#endif
\ No newline at end of file
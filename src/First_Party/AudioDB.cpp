@@ -1,4 +1,5 @@
 #include "AudioDB.h"
+#include "gameData.h"
 
 Mix_Chunk* AudioDB::GetAudioClip(std::string clipName) {
 	// If the clip already exists, retrieve it and return
@@ -28,6 +29,10 @@ Mix_Chunk* AudioDB::GetAudioClip(std::string clipName) {
 }
 
 void AudioDB::PlayClip(std::string clipName, int channel, int loops) {
+	// Headless games never open an audio device
+	if (GameData::headless)
+		return;
+
 	Mix_Chunk* clip = GetAudioClip(clipName);
 
 	AudioHelper::Mix_PlayChannel(channel, clip, loops);
@@ -39,10 +44,12 @@ void AudioDB::Play(int channel, std::string clipName, bool doesLoop) {
 }
 
 int AudioDB::HaltChannel(int channel) {
+	if (GameData::headless)
+		return 0;
 	return AudioHelper::Mix_HaltChannel(channel);
 }
 
 void AudioDB::SetVolume(int channel, int volume) {
-	if (volume >= 0 && volume <= 128)
+	if (!GameData::headless && volume >= 0 && volume <= 128)
 		AudioHelper::Mix_Volume(channel, volume);
 }
@@ -11,7 +11,7 @@ namespace fs = std::filesystem;
 class AudioDB
 {
 public:
-    static inline std::unordered_map<std::string, Mix_Chunk*> audioClips;
+    static inline ENGINE_THREAD_LOCAL std::unordered_map<std::string, Mix_Chunk*> audioClips;
 
     // Public method to access the single instance of the class
     static AudioDB& getInstance() {
@@ -6,6 +6,14 @@
 #include "Raycast.h"
 #include "EventBus.h"
 #include "ParticleSystem.h"
+#include "SystemManager.h"
+#include "Timer.h"
+#include "Tween.h"
+#include "Transform.h"
+#include "ComponentSchema.h"
+#include "DataDB.h"
+#include "NativeComponent.h"
+#include "TagDB.h"
 
 Component::Component(lua_State* lua_state, const std::string& filePath, const std::string& componentName) :
 	hasStart(false), hasUpdate(false), hasLateUpdate(false) {
@@ -20,7 +28,15 @@ Component::Component(lua_State* lua_state, const std::string& filePath, const st
 
 	componentRef = std::make_shared<luabridge::LuaRef>(luabridge::newTable(lua_state));
 
-	ComponentManager::EstablishInheritance(*componentRef, parentTable);
+	// Types that declare a __schema keep those fields in native storage
+	schema = ComponentSchema::Load(lua_state, componentName, parentTable);
+	if (schema != nullptr) {
+		schema_slot = schema->AllocateSlot(-1);
+		schema->Attach(lua_state, *componentRef, parentTable, schema_slot);
+	}
+	else {
+		ComponentManager::EstablishInheritance(*componentRef, parentTable);
+	}
 
 	// Get the Lua component
 	//luabridge::LuaRef luaComponent = luabridge::getGlobal(lua_state, componentName.c_str());
@@ -29,6 +45,7 @@ Component::Component(lua_State* lua_state, const std::string& filePath, const st
 	//componentRef = std::make_shared<luabridge::LuaRef>(luaComponent);
 	(*componentRef)["enabled"] = true;
 	type = componentName;
+	type_id = componentName;
 
 	isCPPComponent = false;
 
@@ -37,13 +54,20 @@ Component::Component(lua_State* lua_state, const std::string& filePath, const st
 	hasUpdate = (*componentRef)["OnUpdate"].isFunction();
 	hasLateUpdate = (*componentRef)["OnLateUpdate"].isFunction();
 	hasOnDestroy = (*componentRef)["OnDestroy"].isFunction();
+	hasOnEnable = (*componentRef)["OnEnable"].isFunction();
+	hasOnDisable = (*componentRef)["OnDisable"].isFunction();
 	hasOnCollisionEnter = (*componentRef)["OnCollisionEnter"].isFunction();
 	hasOnCollisionExit = (*componentRef)["OnCollisionExit"].isFunction();
 	hasOnTriggerEnter = (*componentRef)["OnTriggerEnter"].isFunction();
 	hasOnTriggerExit = (*componentRef)["OnTriggerExit"].isFunction();
+
+	ComponentManager::IndexComponent(this);
 }
 
 bool Component::IsEnabled() {
+	if (native_type != nullptr)
+		return native_type->is_enabled(native_instance);
+
 	//luabridge::LuaRef enabled = (*componentRef)["enabled"];
 
 	//return (enabled.cast<bool>() == true);
@@ -51,13 +75,76 @@ bool Component::IsEnabled() {
 	return (*componentRef)["enabled"].cast<bool>();// == true;
 }
 
+void Component::SetEnabled(bool enabled) {
+	if (native_type != nullptr)
+		native_type->set_enabled(native_instance, enabled);
+	else
+		(*componentRef)["enabled"] = enabled;
+}
+
+void Component::ResetTo(Component* template_component) {
+	if (native_type != nullptr) {
+		native_type->reset(native_instance, template_component->native_instance);
+		return;
+	}
+
+	// Instance tables inherit from the template's table, so dropping every
+	// field set on the instance falls back to the template's values
+	lua_State* lua_state = ComponentManager::GetLuaState();
+	componentRef->push(lua_state);
+	lua_pushnil(lua_state);
+	while (lua_next(lua_state, -2) != 0) {
+		lua_pop(lua_state, 1);
+		lua_pushvalue(lua_state, -1);
+		lua_pushnil(lua_state);
+		lua_rawset(lua_state, -4);
+	}
+	lua_pop(lua_state, 1);
+
+	if (schema != nullptr)
+		schema->CopySlot(schema_slot, template_component->schema_slot);
+}
+
+void Component::CopyFieldsFrom(Component* other) {
+	lua_State* lua_state = ComponentManager::GetLuaState();
+	componentRef->push(lua_state);
+	other->componentRef->push(lua_state);
+	lua_pushnil(lua_state);
+	while (lua_next(lua_state, -2) != 0) {
+		lua_pushvalue(lua_state, -2);
+		lua_insert(lua_state, -2);
+		lua_rawset(lua_state, -5);
+	}
+	lua_pop(lua_state, 2);
+
+	if (schema != nullptr && schema == other->schema)
+		schema->CopySlot(schema_slot, other->schema_slot);
+}
+
 Component::Component(const Component& other, lua_State* lua_state) {
 	componentRef = std::make_shared<luabridge::LuaRef>(luabridge::newTable(lua_state));
 
-	ComponentManager::EstablishInheritance(*componentRef, *other.componentRef);
+	if (other.schema != nullptr) {
+		schema = other.schema;
+		schema_slot = schema->AllocateSlot(other.schema_slot);
+		schema->Attach(lua_state, *componentRef, *other.componentRef, schema_slot);
+	}
+	else {
+		// Every copy of other can share one metatable, no table per instance
+		if (!other.copy_metatable) {
+			other.copy_metatable = std::make_shared<luabridge::LuaRef>(luabridge::newTable(lua_state));
+			(*other.copy_metatable)["__index"] = *other.componentRef;
+		}
+
+		componentRef->push(lua_state);
+		other.copy_metatable->push(lua_state);
+		lua_setmetatable(lua_state, -2);
+		lua_pop(lua_state, 1);
+	}
 
 	(*componentRef)["enabled"] = true;
 	type = other.type;
+	type_id = other.type_id;
 
 	isCPPComponent = false;
 
@@ -66,10 +153,30 @@ Component::Component(const Component& other, lua_State* lua_state) {
 	hasUpdate = other.hasUpdate;
 	hasLateUpdate = other.hasLateUpdate;
 	hasOnDestroy = other.hasOnDestroy;
+	hasOnEnable = other.hasOnEnable;
+	hasOnDisable = other.hasOnDisable;
 	hasOnCollisionEnter = other.hasOnCollisionEnter;
 	hasOnCollisionExit = other.hasOnCollisionExit;
 	hasOnTriggerEnter = other.hasOnTriggerEnter;
 	hasOnTriggerExit = other.hasOnTriggerExit;
+
+	ComponentManager::IndexComponent(this);
+}
+
+Component::~Component() {
+	if (schema != nullptr && schema_slot != -1) {
+		schema->Detach(ComponentManager::GetLuaState(), *componentRef, schema_slot);
+		schema->FreeSlot(schema_slot);
+		schema_slot = -1;
+	}
+
+	if (ref_identity != nullptr)
+		ComponentManager::components_by_ref.erase(ref_identity);
+
+	if (native_type != nullptr) {
+		NativeComponentRegistry::components_by_instance.erase(native_instance);
+		native_type->release(native_instance);
+	}
 }
 
 Component::Component() {
@@ -79,6 +186,8 @@ Component::Component() {
 	hasUpdate = false;
 	hasLateUpdate = false;
 	hasOnDestroy = false;
+	hasOnEnable = false;
+	hasOnDisable = false;
 	hasOnCollisionEnter = false;
 	hasOnCollisionExit = false;
 	hasOnTriggerEnter = false;
@@ -100,15 +209,24 @@ void ComponentManager::Init() {
 		.addProperty("y", &glm::vec2::y)
 		.endClass();
 
+	// Scripts only ever see actors through handles, see ActorHandle
 	luabridge::getGlobalNamespace(lua_state)
-		.beginClass<Actor>("Actor")
-		.addFunction("GetName", &Actor::GetName)
-		.addFunction("GetID", &Actor::GetID)
-		.addFunction("GetComponentByKey", &Actor::GetComponentByKey)
-		.addFunction("GetComponent", &Actor::GetComponent)
-		.addFunction("GetComponents", &Actor::GetComponents)
-		.addFunction("AddComponent", &Actor::AddComponent)
-		.addFunction("RemoveComponent", &Actor::RemoveComponent)
+		.beginClass<ActorHandle>("Actor")
+		.addFunction("GetName", &ActorHandle::GetName)
+		.addFunction("GetID", &ActorHandle::GetID)
+		.addFunction("GetComponentByKey", &ActorHandle::GetComponentByKey)
+		.addFunction("GetComponent", &ActorHandle::GetComponent)
+		.addFunction("GetComponents", &ActorHandle::GetComponents)
+		.addFunction("AddComponent", &ActorHandle::AddComponent)
+		.addFunction("RemoveComponent", &ActorHandle::RemoveComponent)
+		.addFunction("SetActive", &ActorHandle::SetActive)
+		.addFunction("IsActive", &ActorHandle::IsActive)
+		.addFunction("AddTag", &ActorHandle::AddTag)
+		.addFunction("RemoveTag", &ActorHandle::RemoveTag)
+		.addFunction("HasTag", &ActorHandle::HasTag)
+		.addFunction("GetTagMask", &ActorHandle::GetTagMask)
+		.addFunction("IsValid", &ActorHandle::IsValid)
+		.addFunction("__eq", &ActorHandle::operator==)
 		.endClass();
 
 
@@ -116,13 +234,35 @@ void ComponentManager::Init() {
 		.beginNamespace("Actor")
 		.addFunction("Find", &Game::Find)
 		.addFunction("FindAll", &Game::FindAll)
+		.addFunction("FindByTag", &Game::FindByTag)
+		.addFunction("FindByMask", &Game::FindByMask)
+		.addFunction("FindInRadius", &Game::FindInRadius)
+		.addFunction("FindInRect", &Game::FindInRect)
+		.addFunction("FindNearest", &Game::FindNearest)
 		.addFunction("Instantiate", &Game::Instantiate)
+		.addFunction("InstantiateMany", &Game::InstantiateMany)
 		.addFunction("Destroy", &Game::Destroy)
 		.endNamespace();
 
+	luabridge::getGlobalNamespace(lua_state)
+		.beginNamespace("Tag")
+		.addFunction("Mask", &TagDB::LuaMask)
+		.endNamespace();
+
+	luabridge::getGlobalNamespace(lua_state)
+		.beginNamespace("System")
+		.addFunction("Register", &SystemManager::Register)
+		.addFunction("Unregister", &SystemManager::Unregister)
+		.endNamespace();
+
+	luabridge::getGlobalNamespace(lua_state)
+		.beginNamespace("Data")
+		.addFunction("Load", &DataDB::Load)
+		.endNamespace();
+
 	luabridge::getGlobalNamespace(lua_state)
 		.beginNamespace("Application")
-		.addFunction("GetFrame", &Helper::GetFrameNumber) 
+		.addFunction("GetFrame", &GameData::GetFrameNumber) 
 		.addFunction("GetTime", &Game::GetTime)
 		.addFunction("Quit", &Game::Quit)
 		.addFunction("Sleep", &Game::Sleep)
@@ -188,6 +328,7 @@ void ComponentManager::Init() {
 	luabridge::getGlobalNamespace(lua_state)
 		.beginNamespace("Scene")
 		.addFunction("Load", &Game::QueueSceneLoad)
+		.addFunction("Restore", &Game::QueueSceneRestore)
 		.addFunction("GetCurrent", &Game::GetCurrentSceneName)
 		.addFunction("DontDestroy", &Game::DontDestroyOnLoad)
 		.endNamespace();
@@ -284,22 +425,30 @@ void ComponentManager::Init() {
 
 			if (argCount == 1) {
 				// Publish(event_type) with only an event name
-				std::string event_type = luabridge::Stack<std::string>::get(L, 1);
+				Atom event_type = luabridge::Stack<Atom>::get(L, 1);
 				EventBus::Publish(event_type);
 			}
 			else if (argCount == 2) {
 				// Publish(event_type, event_object) with an event object
-				std::string event_type = luabridge::Stack<std::string>::get(L, 1);
+				Atom event_type = luabridge::Stack<Atom>::get(L, 1);
 				luabridge::LuaRef event_object = luabridge::Stack<luabridge::LuaRef>::get(L, 2);
 				EventBus::Publish(event_type, event_object);
 			}
+			else if (argCount == 3) {
+				// Publish(event_type, event_object, tags) only to subscribers whose actor has one of the tags
+				Atom event_type = luabridge::Stack<Atom>::get(L, 1);
+				luabridge::LuaRef event_object = luabridge::Stack<luabridge::LuaRef>::get(L, 2);
+				uint64_t tag_mask = TagDB::MaskFromLua(luabridge::Stack<luabridge::LuaRef>::get(L, 3));
+				EventBus::Publish(event_type, event_object, tag_mask);
+			}
 			else {
-				luaL_error(L, "Event.Publish() expects 1 or 2 arguments."); // Lua error
+				luaL_error(L, "Event.Publish() expects 1 to 3 arguments."); // Lua error
 			}
 
 			return 0; // Lua functions return the number of return values (0 in this case)
 			})
 		.addFunction("Unsubscribe", &EventBus::Unsubscribe)
+		.addFunction("SubscriberCount", &EventBus::SubscriberCount)
 		.endNamespace();
 
 	luabridge::getGlobalNamespace(lua_state)
@@ -348,6 +497,160 @@ void ComponentManager::Init() {
 		.addFunction("Play", &ParticleSystem::Play)
 		.addFunction("Burst", &ParticleSystem::Burst)
 		.endClass();
+
+	luabridge::getGlobalNamespace(lua_state)
+		.beginClass<Timer>("Timer")
+		.addConstructor<void (*) (void)>()
+		.addData("enabled", &Timer::enabled)
+		.addData("key", &Timer::key)
+		.addData("type", &Timer::type)
+		.addData("actor", &Timer::actor)
+		.addData("interval", &Timer::interval)
+		.addData("loop", &Timer::loop)
+		.addData("autostart", &Timer::autostart)
+		.addData("event", &Timer::event)
+
+		.addFunction("OnStart", &Timer::OnStart)
+		.addFunction("OnDestroy", &Timer::OnDestroy)
+		.addFunction("Start", &Timer::Start)
+		.addFunction("Stop", &Timer::Stop)
+		.addFunction("IsRunning", &Timer::IsRunning)
+		.addFunction("GetRemaining", &Timer::GetRemaining)
+		.addFunction("SetCallback", &Timer::SetCallback)
+		.endClass();
+
+	luabridge::getGlobalNamespace(lua_state)
+		.beginClass<Tween>("Tween")
+		.addConstructor<void (*) (void)>()
+		.addData("enabled", &Tween::enabled)
+		.addData("key", &Tween::key)
+		.addData("type", &Tween::type)
+		.addData("actor", &Tween::actor)
+		.addData("target", &Tween::target)
+		.addData("property", &Tween::property)
+		.addData("from", &Tween::from)
+		.addData("to", &Tween::to)
+		.addData("duration", &Tween::duration)
+		.addData("easing", &Tween::easing)
+		.addData("loop", &Tween::loop)
+		.addData("autostart", &Tween::autostart)
+		.addData("event", &Tween::event)
+
+		.addFunction("OnStart", &Tween::OnStart)
+		.addFunction("OnDestroy", &Tween::OnDestroy)
+		.addFunction("Play", &Tween::Play)
+		.addFunction("Stop", &Tween::Stop)
+		.addFunction("IsPlaying", &Tween::IsPlaying)
+		.addFunction("GetValue", &Tween::GetValue)
+		.addFunction("SetCallback", &Tween::SetCallback)
+		.endClass();
+
+	luabridge::getGlobalNamespace(lua_state)
+		.beginClass<Transform>("Transform")
+		.addConstructor<void (*) (void)>()
+		.addData("enabled", &Transform::enabled)
+		.addData("key", &Transform::key)
+		.addData("type", &Transform::type)
+		.addData("actor", &Transform::actor)
+		.addProperty("x", &Transform::GetX, &Transform::SetX)
+		.addProperty("y", &Transform::GetY, &Transform::SetY)
+		.addProperty("rotation", &Transform::GetRotation, &Transform::SetRotation)
+		.addProperty("scale_x", &Transform::GetScaleX, &Transform::SetScaleX)
+		.addProperty("scale_y", &Transform::GetScaleY, &Transform::SetScaleY)
+
+		.addFunction("OnStart", &Transform::OnStart)
+		.addFunction("OnDestroy", &Transform::OnDestroy)
+		.addFunction("GetWorldPosition", &Transform::GetWorldPosition)
+		.addFunction("GetWorldRotation", &Transform::GetWorldRotation)
+		.addFunction("GetWorldScale", &Transform::GetWorldScale)
+		.addFunction("SetWorldPosition", &Transform::SetWorldPosition)
+		.addFunction("SetWorldRotation", &Transform::SetWorldRotation)
+		.addFunction("SetParent", &Transform::SetParent)
+		.addFunction("GetParent", &Transform::LuaGetParent)
+		.addFunction("GetChildren", &Transform::GetChildren)
+		.endClass();
+
+	// Fields listed here are loaded from scene and template json without going through lua
+	NativeComponentRegistry::RegisterNativeComponent<Rigidbody>("Rigidbody")
+		.Field<&Rigidbody::x>("x")
+		.Field<&Rigidbody::y>("y")
+		.Field<&Rigidbody::body_type>("body_type")
+		.Field<&Rigidbody::precise>("precise")
+		.Field<&Rigidbody::gravity_scale>("gravity_scale")
+		.Field<&Rigidbody::density>("density")
+		.Field<&Rigidbody::angular_friction>("angular_friction")
+		.Field<&Rigidbody::rotation>("rotation")
+		.Field<&Rigidbody::has_collider>("has_collider")
+		.Field<&Rigidbody::has_trigger>("has_trigger")
+		.Field<&Rigidbody::collider_type>("collider_type")
+		.Field<&Rigidbody::width>("width")
+		.Field<&Rigidbody::height>("height")
+		.Field<&Rigidbody::radius>("radius")
+		.Field<&Rigidbody::friction>("friction")
+		.Field<&Rigidbody::bounciness>("bounciness")
+		.Field<&Rigidbody::mask_layer>("mask_layer")
+		.Field<&Rigidbody::trigger_type>("trigger_type")
+		.Field<&Rigidbody::trigger_width>("trigger_width")
+		.Field<&Rigidbody::trigger_height>("trigger_height")
+		.Field<&Rigidbody::trigger_radius>("trigger_radius");
+
+	NativeComponentRegistry::RegisterNativeComponent<ParticleSystem>("ParticleSystem")
+		.Field<&ParticleSystem::emit_angle_min>("emit_angle_min")
+		.Field<&ParticleSystem::emit_angle_max>("emit_angle_max")
+		.Field<&ParticleSystem::emit_radius_min>("emit_radius_min")
+		.Field<&ParticleSystem::emit_radius_max>("emit_radius_max")
+		.Field<&ParticleSystem::rotation_min>("rotation_min")
+		.Field<&ParticleSystem::rotation_max>("rotation_max")
+		.Field<&ParticleSystem::start_scale_min>("start_scale_min")
+		.Field<&ParticleSystem::start_scale_max>("start_scale_max")
+		.Field<&ParticleSystem::start_speed_min>("start_speed_min")
+		.Field<&ParticleSystem::start_speed_max>("start_speed_max")
+		.Field<&ParticleSystem::rotation_speed_min>("rotation_speed_min")
+		.Field<&ParticleSystem::rotation_speed_max>("rotation_speed_max")
+		.Field<&ParticleSystem::x>("x")
+		.Field<&ParticleSystem::y>("y")
+		.Field<&ParticleSystem::frames_between_bursts>("frames_between_bursts")
+		.Field<&ParticleSystem::burst_quantity>("burst_quantity")
+		.Field<&ParticleSystem::start_color_r>("start_color_r")
+		.Field<&ParticleSystem::start_color_g>("start_color_g")
+		.Field<&ParticleSystem::start_color_b>("start_color_b")
+		.Field<&ParticleSystem::start_color_a>("start_color_a")
+		.Field<&ParticleSystem::end_color_r>("end_color_r")
+		.Field<&ParticleSystem::end_color_g>("end_color_g")
+		.Field<&ParticleSystem::end_color_b>("end_color_b")
+		.Field<&ParticleSystem::end_color_a>("end_color_a")
+		.Field<&ParticleSystem::image>("image")
+		.Field<&ParticleSystem::sorting_order>("sorting_order")
+		.Field<&ParticleSystem::duration_frames>("duration_frames")
+		.Field<&ParticleSystem::gravity_scale_x>("gravity_scale_x")
+		.Field<&ParticleSystem::gravity_scale_y>("gravity_scale_y")
+		.Field<&ParticleSystem::drag_factor>("drag_factor")
+		.Field<&ParticleSystem::angular_drag_factor>("angular_drag_factor")
+		.Field<&ParticleSystem::end_scale>("end_scale");
+
+	NativeComponentRegistry::RegisterNativeComponent<Timer>("Timer")
+		.Field<&Timer::interval>("interval")
+		.Field<&Timer::loop>("loop")
+		.Field<&Timer::autostart>("autostart")
+		.Field<&Timer::event>("event");
+
+	NativeComponentRegistry::RegisterNativeComponent<Tween>("Tween")
+		.Field<&Tween::target>("target")
+		.Field<&Tween::property>("property")
+		.Field<&Tween::from>("from")
+		.Field<&Tween::to>("to")
+		.Field<&Tween::duration>("duration")
+		.Field<&Tween::easing>("easing")
+		.Field<&Tween::loop>("loop")
+		.Field<&Tween::autostart>("autostart")
+		.Field<&Tween::event>("event");
+
+	NativeComponentRegistry::RegisterNativeComponent<Transform>("Transform")
+		.Property<&Transform::GetX, &Transform::SetX>("x")
+		.Property<&Transform::GetY, &Transform::SetY>("y")
+		.Property<&Transform::GetRotation, &Transform::SetRotation>("rotation")
+		.Property<&Transform::GetScaleX, &Transform::SetScaleX>("scale_x")
+		.Property<&Transform::GetScaleY, &Transform::SetScaleY>("scale_y");
 }
 
 void ComponentManager::EstablishInheritance(luabridge::LuaRef& instance_table, luabridge::LuaRef& parent_table) {
@@ -363,10 +666,9 @@ void ComponentManager::EstablishInheritance(luabridge::LuaRef& instance_table, l
 }
 
 Component* ComponentManager::GetComponentInstance(std::string componentName) {
-	if (componentName == "Rigidbody")
-		return CreateRigidbody();
-	if (componentName == "ParticleSystem")
-		return CreateParticleSystem();
+	NativeComponentType* native_type = NativeComponentRegistry::Find(componentName);
+	if (native_type != nullptr)
+		return native_type->create(*native_type);
 
 	// If the component already exists, retrieve it and return
 	if (luaComponents.find(componentName) != luaComponents.end()) {
@@ -385,94 +687,77 @@ Component* ComponentManager::GetComponentInstance(std::string componentName) {
 	}
 
 	//components[componentName] = IMG_LoadTexture(renderer, imageDir.string().c_str());
-	Component* component = new Component(lua_state, componentDir.string(), componentName);
+	Component* component = component_pool.Create(lua_state, componentDir.string(), componentName);
 
 	luaComponents[componentName] = component;
 
-	Component* comp = new Component(*component, lua_state);
+	Component* comp = component_pool.Create(*component, lua_state);
 
 	return comp;
 }
 
 Component* ComponentManager::GetTemplatedComponentInstance(Component* otherComponent) {
-	if (otherComponent->isCPPComponent)
-		return GetTemplatedCPPComponent(otherComponent);
+	if (otherComponent->native_type != nullptr)
+		return otherComponent->native_type->clone(*otherComponent->native_type, otherComponent);
 
-	return new Component(*otherComponent, lua_state);
+	return component_pool.Create(*otherComponent, lua_state);
 }
 
-Component* ComponentManager::GetTemplatedCPPComponent(Component* otherComponent) {
-	if (otherComponent->type == "Rigidbody")
-		return CreateRigidbodyCopy(otherComponent);
-	if (otherComponent->type == "ParticleSystem")
-		return CreateParticleSystemCopy(otherComponent);
-	return new Component();
-}
+void ComponentManager::IndexComponent(Component* component) {
+	// The table, or for native components the userdata every lookup hands out
+	component->componentRef->push(lua_state);
+	component->ref_identity = lua_topointer(lua_state, -1);
+	lua_pop(lua_state, 1);
 
-lua_State* ComponentManager::GetLuaState() {
-	return lua_state;
+	components_by_ref[component->ref_identity] = component;
 }
 
-void ComponentManager::CppDebugLog(const std::string message) {
-	std::cout << message << "\n";
-}
+Component* ComponentManager::FindComponentByRef(const luabridge::LuaRef& component_ref) {
+	const void* identity = nullptr;
 
-Component* ComponentManager::CreateRigidbody() {
-	Component* component = new Component();
-	Rigidbody* rigidbody = new Rigidbody();
-	//luabridge::LuaRef componentRef(lua_state, rigidbody);
-	component->componentRef = std::make_shared<luabridge::LuaRef>(lua_state, rigidbody);
-
-	//component->rigidbody_ptr = rigidbody;
-	(*component->componentRef)["enabled"] = true;
-	component->type = "Rigidbody";
-	component->isCPPComponent = true;
-	component->hasStart = true;
-	component->hasOnDestroy = true;
-	return component;
-}
+	component_ref.push(lua_state);
+	if (lua_istable(lua_state, -1) || (lua_isuserdata(lua_state, -1) && !lua_islightuserdata(lua_state, -1)))
+		identity = lua_topointer(lua_state, -1);
+	lua_pop(lua_state, 1);
 
-Component* ComponentManager::CreateRigidbodyCopy(Component* otherComponent) {
-	Component* component = new Component();
+	if (identity == nullptr)
+		return nullptr;
 
-	Rigidbody* rigidbody = new Rigidbody(otherComponent->componentRef->cast<Rigidbody*>());
-	
-	component->componentRef = std::make_shared<luabridge::LuaRef>(lua_state, rigidbody);
-
-	//component->rigidbody_ptr = rigidbody;
-	(*component->componentRef)["enabled"] = true;
-	component->type = "Rigidbody";
-	component->isCPPComponent = true;
-	component->hasStart = true;
-	component->hasOnDestroy = true;
-	return component;
+	auto it = components_by_ref.find(identity);
+	return it != components_by_ref.end() ? it->second : nullptr;
 }
 
-Component* ComponentManager::CreateParticleSystem() {
-	Component* component = new Component();
-	ParticleSystem* particleSystem = new ParticleSystem();
-	//luabridge::LuaRef componentRef(lua_state, rigidbody);
-	component->componentRef = std::make_shared<luabridge::LuaRef>(lua_state, particleSystem);
-
-	(*component->componentRef)["enabled"] = true;
-	component->type = "ParticleSystem";
-	component->isCPPComponent = true;
-	component->hasStart = true;
-	component->hasUpdate = true;
+Component* ComponentManager::GetSnapshotComponentInstance(Component* snapshot_component, Component* template_component) {
+	// Native components carry their values, a plain copy is already independent of the snapshot
+	if (snapshot_component->native_type != nullptr)
+		return GetTemplatedComponentInstance(snapshot_component);
+
+	Component* component = template_component != nullptr ?
+		GetTemplatedComponentInstance(template_component) : GetComponentInstance(snapshot_component->type);
+	component->CopyFieldsFrom(snapshot_component);
+
 	return component;
 }
 
-Component* ComponentManager::CreateParticleSystemCopy(Component* otherComponent) {
-	Component* component = new Component();
-
-	ParticleSystem* particleSystem = new ParticleSystem(otherComponent->componentRef->cast<ParticleSystem*>());
+lua_State* ComponentManager::GetLuaState() {
+	return lua_state;
+}
 
-	component->componentRef = std::make_shared<luabridge::LuaRef>(lua_state, particleSystem);
+void ComponentManager::CallLifecycle(Component* component, COMPONENT_LIFECYCLE lifecycle, const std::string& actor_name) {
+	try {
+		if (component->native_type != nullptr) {
+			component->native_type->lifecycle[lifecycle](component->native_instance);
+			return;
+		}
 
-	(*component->componentRef)["enabled"] = true;
-	component->type = "ParticleSystem";
-	component->isCPPComponent = true;
-	component->hasStart = true;
-	component->hasUpdate = true;
-	return component;
+		luabridge::LuaRef function = (*component->componentRef)[lifecycle_names[lifecycle]];
+		function(*component->componentRef);
+	}
+	catch (const luabridge::LuaException& e) {
+		EngineUtils::ReportError(actor_name, component, e);
+	}
 }
+
+void ComponentManager::CppDebugLog(const std::string message) {
+	std::cout << message << "\n";
+}
\ No newline at end of file
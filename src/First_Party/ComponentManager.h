@@ -7,19 +7,48 @@
 #include "utility.h"
 #include "lua/lua.hpp"
 #include "LuaBridge/LuaBridge.h"
+#include "Atom.h"
+#include "SlabPool.h"
 
 namespace fs = std::filesystem;
 
+class ComponentSchema;
+class NativeComponentType;
+
+enum COMPONENT_LIFECYCLE {
+    COMPONENT_LIFECYCLE_START,
+    COMPONENT_LIFECYCLE_UPDATE,
+    COMPONENT_LIFECYCLE_LATE_UPDATE,
+    COMPONENT_LIFECYCLE_DESTROY,
+    COMPONENT_LIFECYCLE_ENABLE,
+    COMPONENT_LIFECYCLE_DISABLE,
+    COMPONENT_LIFECYCLE_COUNT
+};
+
 class Component {
 public:
     explicit Component(lua_State* lua_state, const std::string& filePath, const std::string& componentName);
     explicit Component(const Component& other, lua_State* lua_state);
     explicit Component();
+    ~Component();
 
     bool IsEnabled();
 
+    void SetEnabled(bool enabled);
+
+    // Puts the component back to the values of the template component it was copied from
+    void ResetTo(Component* template_component);
+
+    // Copies the fields set on other's own table (and its schema values) onto this component's.
+    // Values that are tables are shared, not deep copied.
+    void CopyFieldsFrom(Component* other);
+
     std::shared_ptr<luabridge::LuaRef> componentRef;
     std::string type;
+    // Interned type, compared instead of the string on lookups
+    Atom type_id;
+    // Native copy of the "key" field, actors keep their components sorted by it
+    std::string key;
 
     bool isCPPComponent;
 
@@ -27,10 +56,33 @@ public:
     bool hasUpdate;
     bool hasLateUpdate;
     bool hasOnDestroy;
+    bool hasOnEnable;
+    bool hasOnDisable;
     bool hasOnCollisionEnter;
     bool hasOnCollisionExit;
     bool hasOnTriggerEnter;
     bool hasOnTriggerExit;
+
+    // Consecutive frames this component has thrown an error, see ErrorLog
+    int error_streak = 0;
+    int last_error_frame = -1;
+
+    // Index into SystemManager::components_by_type[type], -1 if not live
+    int system_index = -1;
+
+    // Native storage for the fields declared in the type's __schema, if it has one
+    ComponentSchema* schema = nullptr;
+    int schema_slot = -1;
+
+    // Registry entry and instance for C++ components, see NativeComponent.h
+    NativeComponentType* native_type = nullptr;
+    void* native_instance = nullptr;
+
+    // Key of this component in ComponentManager::components_by_ref
+    const void* ref_identity = nullptr;
+
+    // { __index = this component's table }, created by the first copy and shared by all later ones
+    mutable std::shared_ptr<luabridge::LuaRef> copy_metatable;
 };
 
 class ComponentManager
@@ -42,6 +94,9 @@ public:
         return instance;
     }
 
+    // Every component is allocated from here, so add/remove churn reuses slots
+    static inline ENGINE_THREAD_LOCAL SlabPool<Component> component_pool;
+
     // Call before main loop begins
     static void Init();
 
@@ -53,25 +108,37 @@ public:
     // Returns an instance of a component by the type name of the component
     static Component* GetTemplatedComponentInstance(Component* otherComponent);
 
-    static Component* GetTemplatedCPPComponent(Component* otherComponent);
+    // A component with the same values as snapshot_component that inherits from template_component
+    // (or its type, if nullptr) rather than from the snapshot, so resetting it falls back to the template
+    static Component* GetSnapshotComponentInstance(Component* snapshot_component, Component* template_component);
 
-    static void CppDebugLog(const std::string message);
 
-    static lua_State* GetLuaState();
+    // Lua function names of each lifecycle callback
+    static inline const char* lifecycle_names[COMPONENT_LIFECYCLE_COUNT] = { "OnStart", "OnUpdate", "OnLateUpdate", "OnDestroy", "OnEnable", "OnDisable" };
 
-    static Component* CreateRigidbody();
+    // Runs the callback natively for C++ components, through the lua table otherwise.
+    // Errors are reported against actor_name.
+    static void CallLifecycle(Component* component, COMPONENT_LIFECYCLE lifecycle, const std::string& actor_name);
 
-    static Component* CreateRigidbodyCopy(Component* otherComponent);
+    // Lua table (or native userdata) address -> component, so a reference handed
+    // back from lua resolves to its component without comparing LuaRefs
+    static inline ENGINE_THREAD_LOCAL std::unordered_map<const void*, Component*> components_by_ref;
 
-    static Component* CreateParticleSystem();
+    // Adds a component whose componentRef is set to components_by_ref
+    static void IndexComponent(Component* component);
 
-    static Component* CreateParticleSystemCopy(Component* otherComponent);
+    // nullptr if component_ref isn't a live component
+    static Component* FindComponentByRef(const luabridge::LuaRef& component_ref);
+
+    static void CppDebugLog(const std::string message);
+
+    static lua_State* GetLuaState();
 
 private:
-    static inline lua_State* lua_state = nullptr;
+    static inline ENGINE_THREAD_LOCAL lua_State* lua_state = nullptr;
     
     // TODO: maybe remove and just use the lua state for lookups
-    static inline std::unordered_map<std::string, Component*> luaComponents;
+    static inline ENGINE_THREAD_LOCAL std::unordered_map<std::string, Component*> luaComponents;
     //static inline std::unordered_map<std::string, Component*> templates;
 
     // Private constructor and destructor to prevent multiple instances
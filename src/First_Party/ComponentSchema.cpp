@@ -0,0 +1,350 @@
+#include "ComponentSchema.h"
+#include <algorithm>
+#include <cstring>
+
+// Upvalues shared by the __index and __newindex closures
+static const int SCHEMA_UPVALUE = 1;
+static const int SLOT_UPVALUE = 2;
+static const int FIELD_TABLE_UPVALUE = 3;
+static const int PARENT_UPVALUE = 4;
+
+ComponentSchema* ComponentSchema::Load(lua_State* lua_state, const std::string& type_name, luabridge::LuaRef& type_table) {
+	auto existing = schemas.find(type_name);
+	if (existing != schemas.end())
+		return existing->second;
+
+	luabridge::LuaRef schema_table = type_table["__schema"];
+	if (!schema_table.isTable())
+		return nullptr;
+
+	ComponentSchema* schema = new ComponentSchema();
+	schema->type = type_name;
+
+	for (luabridge::Iterator it(schema_table); !it.isNil(); ++it) {
+		if (!it.key().isString() || !it.value().isString())
+			continue;
+
+		SchemaField field;
+		field.name = it.key().tostring();
+		field.type = ParseFieldType(it.value().tostring());
+		field.column = -1;
+		schema->fields.emplace_back(field);
+	}
+
+	// Iteration order of a lua table isn't stable, keep the layout deterministic
+	std::sort(schema->fields.begin(), schema->fields.end(), [](const SchemaField& a, const SchemaField& b) {
+		return a.name < b.name;
+	});
+
+	luabridge::LuaRef field_table = luabridge::newTable(lua_state);
+
+	for (int i = 0; i < static_cast<int>(schema->fields.size()); i++) {
+		SchemaField& field = schema->fields[i];
+		luabridge::LuaRef default_value = type_table[field.name];
+
+		switch (field.type) {
+		case SCHEMA_FIELD_FLOAT:
+			field.column = static_cast<int>(schema->float_columns.size());
+			schema->float_columns.emplace_back();
+			schema->default_floats.emplace_back(default_value.isNumber() ? default_value.cast<float>() : 0.0f);
+			break;
+		case SCHEMA_FIELD_INT:
+			field.column = static_cast<int>(schema->int_columns.size());
+			schema->int_columns.emplace_back();
+			schema->default_ints.emplace_back(default_value.isNumber() ? default_value.cast<int>() : 0);
+			break;
+		case SCHEMA_FIELD_BOOL:
+			field.column = static_cast<int>(schema->bool_columns.size());
+			schema->bool_columns.emplace_back();
+			schema->default_bools.emplace_back(default_value.isBool() ? default_value.cast<bool>() : false);
+			break;
+		case SCHEMA_FIELD_STRING:
+			field.column = static_cast<int>(schema->string_columns.size());
+			schema->string_columns.emplace_back();
+			schema->default_strings.emplace_back(default_value.isString() ? default_value.tostring() : "");
+			break;
+		}
+
+		schema->field_indices[field.name] = i;
+		field_table[field.name] = i;
+	}
+
+	field_table.push(lua_state);
+	schema->field_table_ref = luaL_ref(lua_state, LUA_REGISTRYINDEX);
+
+	schemas[type_name] = schema;
+	return schema;
+}
+
+ComponentSchema* ComponentSchema::GetSchema(const std::string& type_name) {
+	auto schema = schemas.find(type_name);
+	if (schema == schemas.end())
+		return nullptr;
+
+	return schema->second;
+}
+
+int ComponentSchema::FindField(const std::string& field_name) {
+	auto field = field_indices.find(field_name);
+	if (field == field_indices.end())
+		return -1;
+
+	return field->second;
+}
+
+int ComponentSchema::AllocateSlot(int copy_from_slot) {
+	int slot = 0;
+
+	if (!free_slots.empty()) {
+		slot = free_slots.back();
+		free_slots.pop_back();
+	}
+	else {
+		slot = slot_count++;
+		for (std::vector<float>& column : float_columns) column.emplace_back();
+		for (std::vector<int>& column : int_columns) column.emplace_back();
+		for (std::vector<uint8_t>& column : bool_columns) column.emplace_back();
+		for (std::vector<std::string>& column : string_columns) column.emplace_back();
+	}
+
+	if (copy_from_slot >= 0) {
+		CopySlot(slot, copy_from_slot);
+	}
+	else {
+		for (size_t i = 0; i < float_columns.size(); i++) float_columns[i][slot] = default_floats[i];
+		for (size_t i = 0; i < int_columns.size(); i++) int_columns[i][slot] = default_ints[i];
+		for (size_t i = 0; i < bool_columns.size(); i++) bool_columns[i][slot] = default_bools[i];
+		for (size_t i = 0; i < string_columns.size(); i++) string_columns[i][slot] = default_strings[i];
+	}
+
+	return slot;
+}
+
+void ComponentSchema::FreeSlot(int slot) {
+	if (slot < 0)
+		return;
+
+	for (std::vector<std::string>& column : string_columns) column[slot].clear();
+	free_slots.emplace_back(slot);
+}
+
+void ComponentSchema::CopySlot(int slot, int copy_from_slot) {
+	if (slot < 0 || copy_from_slot < 0)
+		return;
+
+	for (std::vector<float>& column : float_columns) column[slot] = column[copy_from_slot];
+	for (std::vector<int>& column : int_columns) column[slot] = column[copy_from_slot];
+	for (std::vector<uint8_t>& column : bool_columns) column[slot] = column[copy_from_slot];
+	for (std::vector<std::string>& column : string_columns) column[slot] = column[copy_from_slot];
+}
+
+void ComponentSchema::Attach(lua_State* lua_state, luabridge::LuaRef& instance_table, luabridge::LuaRef& parent_table, int slot) {
+	instance_table.push(lua_state);
+
+	lua_createtable(lua_state, 0, 2);
+
+	lua_pushlightuserdata(lua_state, this);
+	lua_pushinteger(lua_state, slot);
+	lua_rawgeti(lua_state, LUA_REGISTRYINDEX, field_table_ref);
+	parent_table.push(lua_state);
+	lua_pushcclosure(lua_state, IndexMetamethod, 4);
+	lua_setfield(lua_state, -2, "__index");
+
+	lua_pushlightuserdata(lua_state, this);
+	lua_pushinteger(lua_state, slot);
+	lua_rawgeti(lua_state, LUA_REGISTRYINDEX, field_table_ref);
+	parent_table.push(lua_state);
+	lua_pushcclosure(lua_state, NewIndexMetamethod, 4);
+	lua_setfield(lua_state, -2, "__newindex");
+
+	lua_setmetatable(lua_state, -2);
+	lua_pop(lua_state, 1);
+}
+
+void ComponentSchema::Detach(lua_State* lua_state, luabridge::LuaRef& instance_table, int slot) {
+	instance_table.push(lua_state);
+
+	for (int i = 0; i < static_cast<int>(fields.size()); i++) {
+		lua_pushstring(lua_state, fields[i].name.c_str());
+		PushField(lua_state, slot, i);
+		lua_rawset(lua_state, -3);
+	}
+
+	// Point both closures at no slot, they then behave like plain inheritance
+	if (lua_getmetatable(lua_state, -1)) {
+		const char* metamethods[] = { "__index", "__newindex" };
+		for (const char* metamethod : metamethods) {
+			lua_getfield(lua_state, -1, metamethod);
+			if (lua_iscfunction(lua_state, -1)) {
+				lua_pushinteger(lua_state, -1);
+				lua_setupvalue(lua_state, -2, SLOT_UPVALUE);
+			}
+			lua_pop(lua_state, 1);
+		}
+		lua_pop(lua_state, 1);
+	}
+
+	lua_pop(lua_state, 1);
+}
+
+void ComponentSchema::PushField(lua_State* lua_state, int slot, int field_index) {
+	const SchemaField& field = fields[field_index];
+
+	switch (field.type) {
+	case SCHEMA_FIELD_FLOAT:
+		lua_pushnumber(lua_state, float_columns[field.column][slot]);
+		break;
+	case SCHEMA_FIELD_INT:
+		lua_pushinteger(lua_state, int_columns[field.column][slot]);
+		break;
+	case SCHEMA_FIELD_BOOL:
+		lua_pushboolean(lua_state, bool_columns[field.column][slot]);
+		break;
+	case SCHEMA_FIELD_STRING:
+		lua_pushlstring(lua_state, string_columns[field.column][slot].data(), string_columns[field.column][slot].size());
+		break;
+	}
+}
+
+void ComponentSchema::SetFieldFromLua(lua_State* lua_state, int slot, int field_index, int value_index) {
+	const SchemaField& field = fields[field_index];
+
+	// A value of the wrong type is a script error, not a silent 0 / false / ""
+	bool valid = false;
+	switch (field.type) {
+	case SCHEMA_FIELD_FLOAT:
+	case SCHEMA_FIELD_INT:
+		valid = lua_isnumber(lua_state, value_index);
+		break;
+	case SCHEMA_FIELD_BOOL:
+		valid = lua_isboolean(lua_state, value_index) || (lua_type(lua_state, value_index) == LUA_TSTRING &&
+			(std::strcmp(lua_tostring(lua_state, value_index), "true") == 0 || std::strcmp(lua_tostring(lua_state, value_index), "false") == 0));
+		break;
+	case SCHEMA_FIELD_STRING:
+		valid = lua_isstring(lua_state, value_index);
+		break;
+	}
+	if (!valid) {
+		luaL_error(lua_state, "can't assign a %s to %s field '%s' of %s", luaL_typename(lua_state, value_index),
+			FieldTypeName(field.type), field.name.c_str(), type.c_str());
+		return;
+	}
+
+	switch (field.type) {
+	case SCHEMA_FIELD_FLOAT:
+		float_columns[field.column][slot] = static_cast<float>(lua_tonumber(lua_state, value_index));
+		break;
+	case SCHEMA_FIELD_INT:
+		int_columns[field.column][slot] = static_cast<int>(lua_tonumber(lua_state, value_index));
+		break;
+	case SCHEMA_FIELD_BOOL:
+		if (lua_type(lua_state, value_index) == LUA_TSTRING)
+			bool_columns[field.column][slot] = (std::string(lua_tostring(lua_state, value_index)) == "true");
+		else
+			bool_columns[field.column][slot] = lua_toboolean(lua_state, value_index);
+		break;
+	case SCHEMA_FIELD_STRING: {
+		size_t length = 0;
+		const char* value = luaL_tolstring(lua_state, value_index, &length);
+		string_columns[field.column][slot].assign(value, length);
+		lua_pop(lua_state, 1);
+		break;
+	}
+	}
+}
+
+void ComponentSchema::SetFieldFromJson(int slot, int field_index, const rapidjson::Value& value) {
+	const SchemaField& field = fields[field_index];
+
+	switch (field.type) {
+	case SCHEMA_FIELD_FLOAT:
+		if (value.IsNumber()) float_columns[field.column][slot] = value.GetFloat();
+		break;
+	case SCHEMA_FIELD_INT:
+		if (value.IsNumber()) int_columns[field.column][slot] = static_cast<int>(value.GetDouble());
+		break;
+	case SCHEMA_FIELD_BOOL:
+		if (value.IsBool()) bool_columns[field.column][slot] = value.GetBool();
+		break;
+	case SCHEMA_FIELD_STRING:
+		if (value.IsString()) string_columns[field.column][slot] = value.GetString();
+		break;
+	}
+}
+
+float ComponentSchema::GetFloat(int slot, int field_index) {
+	const SchemaField& field = fields[field_index];
+
+	if (field.type == SCHEMA_FIELD_FLOAT) return float_columns[field.column][slot];
+	if (field.type == SCHEMA_FIELD_INT) return static_cast<float>(int_columns[field.column][slot]);
+	return 0.0f;
+}
+
+void ComponentSchema::SetFloat(int slot, int field_index, float value) {
+	const SchemaField& field = fields[field_index];
+
+	if (field.type == SCHEMA_FIELD_FLOAT) float_columns[field.column][slot] = value;
+	else if (field.type == SCHEMA_FIELD_INT) int_columns[field.column][slot] = static_cast<int>(value);
+}
+
+int ComponentSchema::IndexMetamethod(lua_State* lua_state) {
+	// (instance, key)
+	lua_Integer slot = lua_tointeger(lua_state, lua_upvalueindex(SLOT_UPVALUE));
+
+	if (slot >= 0) {
+		lua_pushvalue(lua_state, 2);
+		if (lua_rawget(lua_state, lua_upvalueindex(FIELD_TABLE_UPVALUE)) == LUA_TNUMBER) {
+			int field_index = static_cast<int>(lua_tointeger(lua_state, -1));
+			lua_pop(lua_state, 1);
+
+			ComponentSchema* schema = static_cast<ComponentSchema*>(lua_touserdata(lua_state, lua_upvalueindex(SCHEMA_UPVALUE)));
+			schema->PushField(lua_state, static_cast<int>(slot), field_index);
+			return 1;
+		}
+		lua_pop(lua_state, 1);
+	}
+
+	// Not a schema field, inherit from the parent like a plain __index table would
+	lua_pushvalue(lua_state, 2);
+	lua_gettable(lua_state, lua_upvalueindex(PARENT_UPVALUE));
+	return 1;
+}
+
+int ComponentSchema::NewIndexMetamethod(lua_State* lua_state) {
+	// (instance, key, value)
+	lua_Integer slot = lua_tointeger(lua_state, lua_upvalueindex(SLOT_UPVALUE));
+
+	if (slot >= 0) {
+		lua_pushvalue(lua_state, 2);
+		if (lua_rawget(lua_state, lua_upvalueindex(FIELD_TABLE_UPVALUE)) == LUA_TNUMBER) {
+			int field_index = static_cast<int>(lua_tointeger(lua_state, -1));
+			lua_pop(lua_state, 1);
+
+			ComponentSchema* schema = static_cast<ComponentSchema*>(lua_touserdata(lua_state, lua_upvalueindex(SCHEMA_UPVALUE)));
+			schema->SetFieldFromLua(lua_state, static_cast<int>(slot), field_index, 3);
+			return 0;
+		}
+		lua_pop(lua_state, 1);
+	}
+
+	lua_pushvalue(lua_state, 2);
+	lua_pushvalue(lua_state, 3);
+	lua_rawset(lua_state, 1);
+	return 0;
+}
+
+const char* ComponentSchema::FieldTypeName(SCHEMA_FIELD_TYPE field_type) {
+	switch (field_type) {
+	case SCHEMA_FIELD_INT: return "int";
+	case SCHEMA_FIELD_BOOL: return "bool";
+	case SCHEMA_FIELD_STRING: return "string";
+	default: return "float";
+	}
+}
+
+SCHEMA_FIELD_TYPE ComponentSchema::ParseFieldType(const std::string& type_name) {
+	if (type_name == "int" || type_name == "integer") return SCHEMA_FIELD_INT;
+	if (type_name == "bool" || type_name == "boolean") return SCHEMA_FIELD_BOOL;
+	if (type_name == "string") return SCHEMA_FIELD_STRING;
+	return SCHEMA_FIELD_FLOAT;
+}
\ No newline at end of file
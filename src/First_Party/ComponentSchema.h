@@ -0,0 +1,98 @@
+#pragma once
+#ifndef COMPONENTSCHEMA_H
+#define COMPONENTSCHEMA_H
+
+#include <unordered_map>
+#include <vector>
+#include "utility.h"
+
+enum SCHEMA_FIELD_TYPE {
+	SCHEMA_FIELD_FLOAT,
+	SCHEMA_FIELD_INT,
+	SCHEMA_FIELD_BOOL,
+	SCHEMA_FIELD_STRING
+};
+
+class SchemaField {
+public:
+	std::string name;
+	SCHEMA_FIELD_TYPE type;
+	// Index into the column array of this field's type
+	int column;
+};
+
+// Native storage for a Lua component type that declares a schema, e.g.
+//     Health = { hp = 100, max = 100, __schema = { hp = "float", max = "float" } }
+// Every instance of the type owns a slot (row) in struct-of-arrays columns.
+// Instance tables get __index/__newindex closures that read and write the
+// columns directly, everything else falls through to the parent table.
+class ComponentSchema
+{
+public:
+	static inline ENGINE_THREAD_LOCAL std::unordered_map<std::string, ComponentSchema*> schemas;
+
+	std::string type;
+	std::vector<SchemaField> fields;
+	std::unordered_map<std::string, int> field_indices;
+
+	std::vector<std::vector<float>> float_columns;
+	std::vector<std::vector<int>> int_columns;
+	std::vector<std::vector<uint8_t>> bool_columns;
+	std::vector<std::vector<std::string>> string_columns;
+
+	// Default row, read from the component's global table
+	std::vector<float> default_floats;
+	std::vector<int> default_ints;
+	std::vector<uint8_t> default_bools;
+	std::vector<std::string> default_strings;
+
+	std::vector<int> free_slots;
+	int slot_count = 0;
+
+	// Registry ref to a lua table of field name -> field index, shared by every instance
+	int field_table_ref = LUA_NOREF;
+
+	// Creates the schema if the component's global table declares __schema, otherwise returns nullptr
+	static ComponentSchema* Load(lua_State* lua_state, const std::string& type_name, luabridge::LuaRef& type_table);
+
+	static ComponentSchema* GetSchema(const std::string& type_name);
+
+	int FindField(const std::string& field_name);
+
+	// Allocates a row, copying from copy_from_slot (or the defaults if -1)
+	int AllocateSlot(int copy_from_slot);
+
+	void FreeSlot(int slot);
+
+	void CopySlot(int slot, int copy_from_slot);
+
+	// Set instance_table's metatable to the schema accessors for this slot, falling back to parent_table
+	void Attach(lua_State* lua_state, luabridge::LuaRef& instance_table, luabridge::LuaRef& parent_table, int slot);
+
+	// Copy the slot's values into instance_table and stop redirecting to the columns,
+	// so lua references that outlive the component keep working
+	void Detach(lua_State* lua_state, luabridge::LuaRef& instance_table, int slot);
+
+	void PushField(lua_State* lua_state, int slot, int field_index);
+
+	// Writes the lua value at stack index value_index, coercing it to the field's type. A value that
+	// isn't one of the field's type (numbers for strings, "true"/"false" for bools) raises a lua error.
+	void SetFieldFromLua(lua_State* lua_state, int slot, int field_index, int value_index);
+
+	void SetFieldFromJson(int slot, int field_index, const rapidjson::Value& value);
+
+	float GetFloat(int slot, int field_index);
+
+	void SetFloat(int slot, int field_index, float value);
+
+private:
+	static int IndexMetamethod(lua_State* lua_state);
+
+	static int NewIndexMetamethod(lua_State* lua_state);
+
+	static SCHEMA_FIELD_TYPE ParseFieldType(const std::string& type_name);
+
+	static const char* FieldTypeName(SCHEMA_FIELD_TYPE field_type);
+};
+
+#endif
\ No newline at end of file
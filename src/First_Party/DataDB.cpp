@@ -0,0 +1,115 @@
+#include "DataDB.h"
+#include "ComponentManager.h"
+
+luabridge::LuaRef DataDB::Load(const std::string& dataName) {
+	// If the data already exists, retrieve it and return
+	auto cached = data_tables.find(dataName);
+	if (cached != data_tables.end()) {
+		return *cached->second;
+	}
+
+	// Get the path of the current executable
+	fs::path exePath = fs::current_path();
+
+	fs::path dataDir = exePath / "resources" / "data" / (dataName + ".json");
+
+	if (!fs::exists(dataDir)) {
+		std::cout << "error: data " << dataName << " is missing";
+		exit(0);
+	}
+
+	rapidjson::Document dataDoc;
+	EngineUtils::ReadJsonFile(dataDir.string(), dataDoc);
+
+	lua_State* lua_state = ComponentManager::GetLuaState();
+
+	PushJsonValue(lua_state, dataDoc);
+	std::shared_ptr<luabridge::LuaRef> data = std::make_shared<luabridge::LuaRef>(luabridge::LuaRef::fromStack(lua_state));
+
+	data_tables[dataName] = data;
+
+	return *data;
+}
+
+void DataDB::PushJsonValue(lua_State* lua_state, const rapidjson::Value& value) {
+	luaL_checkstack(lua_state, 3, "data file nested too deeply");
+
+	if (value.IsObject()) {
+		lua_createtable(lua_state, 0, static_cast<int>(value.MemberCount()));
+		for (auto it = value.MemberBegin(); it != value.MemberEnd(); ++it) {
+			lua_pushlstring(lua_state, it->name.GetString(), it->name.GetStringLength());
+			PushJsonValue(lua_state, it->value);
+			lua_rawset(lua_state, -3);
+		}
+		MakeReadOnly(lua_state);
+	}
+	else if (value.IsArray()) {
+		lua_createtable(lua_state, static_cast<int>(value.Size()), 0);
+		lua_Integer index = 1; // Lua tables are 1-based
+		for (auto it = value.Begin(); it != value.End(); ++it) {
+			PushJsonValue(lua_state, *it);
+			lua_rawseti(lua_state, -2, index++);
+		}
+		MakeReadOnly(lua_state);
+	}
+	else if (value.IsString()) {
+		lua_pushlstring(lua_state, value.GetString(), value.GetStringLength());
+	}
+	else if (value.IsInt64()) {
+		lua_pushinteger(lua_state, static_cast<lua_Integer>(value.GetInt64()));
+	}
+	else if (value.IsNumber()) {
+		lua_pushnumber(lua_state, value.GetDouble());
+	}
+	else if (value.IsBool()) {
+		lua_pushboolean(lua_state, value.GetBool());
+	}
+	else {
+		lua_pushnil(lua_state);
+	}
+}
+
+void DataDB::MakeReadOnly(lua_State* lua_state) {
+	// [table] -> [proxy], proxy's metatable reads from table and rejects writes
+	lua_createtable(lua_state, 0, 0);
+
+	lua_createtable(lua_state, 0, 5);
+	lua_pushvalue(lua_state, -3);
+	lua_setfield(lua_state, -2, "__index");
+	lua_pushcfunction(lua_state, ReadOnlyNewIndex);
+	lua_setfield(lua_state, -2, "__newindex");
+	lua_pushcfunction(lua_state, ReadOnlyLength);
+	lua_setfield(lua_state, -2, "__len");
+	lua_pushcfunction(lua_state, ReadOnlyPairs);
+	lua_setfield(lua_state, -2, "__pairs");
+	lua_pushboolean(lua_state, 0);
+	lua_setfield(lua_state, -2, "__metatable");
+
+	lua_setmetatable(lua_state, -2);
+	lua_remove(lua_state, -2);
+}
+
+int DataDB::ReadOnlyNewIndex(lua_State* lua_state) {
+	return luaL_error(lua_state, "data tables loaded with Data.Load are read-only");
+}
+
+// The proxies are empty, so length and iteration have to go to the real table
+// kept as __index in the proxy's metatable
+static void PushProxiedTable(lua_State* lua_state, int proxy_index) {
+	lua_getmetatable(lua_state, proxy_index);
+	lua_getfield(lua_state, -1, "__index");
+	lua_remove(lua_state, -2);
+}
+
+int DataDB::ReadOnlyLength(lua_State* lua_state) {
+	PushProxiedTable(lua_state, 1);
+	lua_pushinteger(lua_state, static_cast<lua_Integer>(lua_rawlen(lua_state, -1)));
+	return 1;
+}
+
+int DataDB::ReadOnlyPairs(lua_State* lua_state) {
+	lua_getglobal(lua_state, "next");
+	PushProxiedTable(lua_state, 1);
+	lua_pushnil(lua_state);
+	return 3;
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+#ifndef DATADB_H
+#define DATADB_H
+
+#include <filesystem>
+#include <unordered_map>
+#include "utility.h"
+
+namespace fs = std::filesystem;
+
+class DataDB
+{
+public:
+	// Read-only lua tables built from resources/data/*.json, shared by every caller
+	static inline ENGINE_THREAD_LOCAL std::unordered_map<std::string, std::shared_ptr<luabridge::LuaRef>> data_tables;
+
+	// Public method to access the single instance of the class
+	static DataDB& getInstance() {
+		static DataDB instance; // Guaranteed to be created only once
+		return instance;
+	}
+
+	// Data.Load(name): loads resources/data/name.json into a read-only lua table, cached after the first call
+	static luabridge::LuaRef Load(const std::string& dataName);
+
+private:
+	// Push the json value onto the lua stack, building tables pre-sized from the json
+	static void PushJsonValue(lua_State* lua_state, const rapidjson::Value& value);
+
+	// Replace the table on top of the stack with a read-only proxy of it
+	static void MakeReadOnly(lua_State* lua_state);
+
+	static int ReadOnlyNewIndex(lua_State* lua_state);
+
+	static int ReadOnlyLength(lua_State* lua_state);
+
+	static int ReadOnlyPairs(lua_State* lua_state);
+
+	// Private constructor and destructor to prevent multiple instances
+	DataDB() {}
+	~DataDB() = default;
+
+	// Delete copy constructor and assignment operator to prevent copying
+	DataDB(const DataDB&) = delete;
+	DataDB& operator=(const DataDB&) = delete;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,169 @@
+#include "ErrorLog.h"
+#include "ComponentManager.h"
+#include "gameData.h"
+
+void ErrorLog::Init() {
+	rapidjson::Document& gameConfig = GameData::gameConfig;
+
+	if (gameConfig.IsObject()) {
+		if (gameConfig.HasMember("script_error_disable_frames") && gameConfig["script_error_disable_frames"].IsInt())
+			disable_after_frames = gameConfig["script_error_disable_frames"].GetInt();
+		if (gameConfig.HasMember("script_error_summary_frames") && gameConfig["script_error_summary_frames"].IsInt())
+			summary_interval_frames = std::max(1, gameConfig["script_error_summary_frames"].GetInt());
+	}
+
+	std::lock_guard<std::mutex> lock(queue_mutex);
+	if (running)
+		return;
+
+	running = true;
+	worker = std::thread(WorkerLoop);
+
+	// Make sure queued errors still make it out if the game calls exit()
+	std::atexit(ErrorLog::Shutdown);
+}
+
+void ErrorLog::Report(const std::string& actor_name, const std::string& component_type, const char* raw_message) {
+	std::string record_key = component_type;
+	record_key += '\x1f';
+	record_key += raw_message;
+
+	ErrorRecord& record = records[record_key];
+	record.count++;
+
+	// Only the first occurrence is written right away, the rest get summarized in EndFrame
+	if (record.count == 1) {
+		record.actor_name = actor_name;
+		record.message = raw_message;
+		record.reported = 1;
+		Enqueue({ actor_name, record.message, 0 });
+
+		record_order.emplace_back(std::move(record_key));
+		if (records.size() > MAX_RECORDS)
+			DropOldestRecord();
+	}
+}
+
+void ErrorLog::DropOldestRecord() {
+	auto oldest = records.find(record_order.front());
+	record_order.pop_front();
+	if (oldest == records.end())
+		return;
+
+	// Repeats not summarized yet still get written
+	ErrorRecord& record = oldest->second;
+	if (record.count > record.reported)
+		Enqueue({ record.actor_name, record.message, record.count - record.reported });
+
+	records.erase(oldest);
+}
+
+void ErrorLog::RecordComponentFailure(const std::string& actor_name, Component* component) {
+	int frame = GameData::GetFrameNumber();
+
+	// Multiple failures in the same frame (OnUpdate and OnLateUpdate) only count once
+	if (component->last_error_frame == frame)
+		return;
+
+	if (component->last_error_frame == frame - 1)
+		component->error_streak++;
+	else
+		component->error_streak = 1;
+
+	component->last_error_frame = frame;
+
+	if (disable_after_frames > 0 && component->error_streak >= disable_after_frames) {
+		component->SetEnabled(false);
+		component->error_streak = 0;
+
+		Enqueue({ actor_name, component->type + " disabled after failing " +
+			std::to_string(disable_after_frames) + " frames in a row", 0 });
+	}
+}
+
+void ErrorLog::EndFrame() {
+	if (records.empty() || GameData::GetFrameNumber() % summary_interval_frames != 0)
+		return;
+
+	for (auto it = records.begin(); it != records.end(); ++it) {
+		ErrorRecord& record = it->second;
+		if (record.count > record.reported) {
+			Enqueue({ record.actor_name, record.message, record.count - record.reported });
+			record.reported = record.count;
+		}
+	}
+}
+
+void ErrorLog::Shutdown() {
+	{
+		std::lock_guard<std::mutex> lock(queue_mutex);
+		if (!running)
+			return;
+		running = false;
+	}
+
+	queue_condition.notify_one();
+
+	if (worker.joinable())
+		worker.join();
+}
+
+void ErrorLog::Enqueue(LogEntry entry) {
+	{
+		std::lock_guard<std::mutex> lock(queue_mutex);
+		queued_entries.emplace_back(std::move(entry));
+	}
+
+	queue_condition.notify_one();
+}
+
+void ErrorLog::WorkerLoop() {
+	std::vector<LogEntry> entries;
+	std::string output;
+
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(queue_mutex);
+			queue_condition.wait(lock, [] { return !queued_entries.empty() || !running; });
+
+			if (queued_entries.empty() && !running)
+				break;
+
+			entries.swap(queued_entries);
+		}
+
+		// Build the whole batch and write it at once
+		output.clear();
+		for (LogEntry& entry : entries) {
+			output += "\033[31m";
+			output += entry.actor_name;
+			output += " : ";
+			output += NormalizeMessage(entry.message);
+			if (entry.repeat_count > 0) {
+				output += " (repeated ";
+				output += std::to_string(entry.repeat_count);
+				output += " more times)";
+			}
+			output += "\033[0m\n";
+		}
+		entries.clear();
+
+		std::cout << output << std::flush;
+	}
+}
+
+std::string ErrorLog::NormalizeMessage(const std::string& raw_message) {
+	std::string error_message = raw_message;
+
+	// Normalize file paths across platforms
+	std::replace(error_message.begin(), error_message.end(), '\\', '/');
+
+	// Find the "resources/" folder and strip everything before it
+	std::string target = "resources/";
+	size_t pos = error_message.find(target);
+	if (pos != std::string::npos) {
+		error_message = error_message.substr(pos); // Keep everything from "resources/" onwards
+	}
+
+	return error_message;
+}
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+#ifndef ERRORLOG_H
+#define ERRORLOG_H
+
+#include <unordered_map>
+#include <vector>
+#include <deque>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "utility.h"
+
+class Component;
+
+// A single line waiting to be written by the log thread. Formatting (path
+// normalization, color codes) is deferred to the log thread so the frame
+// only pays for a move into the queue.
+struct LogEntry {
+	std::string actor_name;
+	std::string message;
+	int repeat_count;
+};
+
+// Errors are de-duplicated by (component type, raw message)
+struct ErrorRecord {
+	std::string actor_name;
+	std::string message;
+	int count = 0;
+	int reported = 0;
+};
+
+class ErrorLog
+{
+public:
+	// Number of consecutive failing frames before a component is disabled (0 never disables)
+	static inline ENGINE_THREAD_LOCAL int disable_after_frames = 30;
+
+	// How often (in frames) repeated errors get summarized
+	static inline ENGINE_THREAD_LOCAL int summary_interval_frames = 60;
+
+	// Public method to access the single instance of the class
+	static ErrorLog& getInstance() {
+		static ErrorLog instance; // Guaranteed to be created only once
+		return instance;
+	}
+
+	// Call before main loop begins
+	static void Init();
+
+	// Log raw_message, raised by a component_type component of actor_name ("" when no component
+	// raised it). The first occurrence of each (component type, message) is written right away,
+	// repeats are only counted and summarized by EndFrame.
+	static void Report(const std::string& actor_name, const std::string& component_type, const char* raw_message);
+
+	// Track consecutive failing frames for a component, disabling it once it reaches the limit
+	static void RecordComponentFailure(const std::string& actor_name, Component* component);
+
+	// Summarize repeated errors, call once at the end of every frame
+	static void EndFrame();
+
+	// Flush everything that is queued and join the log thread
+	static void Shutdown();
+
+private:
+	// Messages can embed frame numbers or positions, so past this many distinct errors the oldest is dropped
+	static inline const size_t MAX_RECORDS = 1024;
+
+	static inline ENGINE_THREAD_LOCAL std::unordered_map<std::string, ErrorRecord> records;
+	// Keys of records, oldest first
+	static inline ENGINE_THREAD_LOCAL std::deque<std::string> record_order;
+
+	// The log thread is shared by every game in the process
+	static inline std::mutex queue_mutex;
+	static inline std::condition_variable queue_condition;
+	static inline std::vector<LogEntry> queued_entries;
+	static inline std::thread worker;
+	static inline bool running = false;
+
+	static void Enqueue(LogEntry entry);
+
+	// Evicts the oldest record once there are more than MAX_RECORDS
+	static void DropOldestRecord();
+
+	static void WorkerLoop();
+
+	static std::string NormalizeMessage(const std::string& raw_message);
+
+	// Private constructor and destructor to prevent multiple instances
+	ErrorLog() {}
+	~ErrorLog() = default;
+
+	// Delete copy constructor and assignment operator to prevent copying
+	ErrorLog(const ErrorLog&) = delete;
+	ErrorLog& operator=(const ErrorLog&) = delete;
+};
+
+#endif
\ No newline at end of file
@@ -1,10 +1,17 @@
 #include "EventBus.h"
 #include "ComponentManager.h"
 
-Subscription::Subscription(std::string _event_type, const luabridge::LuaRef& _component, const luabridge::LuaRef& _function) {
+Subscription::Subscription(Atom _event_type, const luabridge::LuaRef& _component, const luabridge::LuaRef& _function) {
     event_type = _event_type;
     component = std::make_shared<luabridge::LuaRef>(_component);
     function = std::make_shared<luabridge::LuaRef>(_function);
+
+    if (_component.isTable() || _component.isUserdata()) {
+        luabridge::LuaRef actor_ref = _component["actor"];
+        Actor* subscriber_actor = actor_ref.isUserdata() ? actor_ref.cast<Actor*>() : nullptr;
+        if (subscriber_actor != nullptr)
+            actor = ActorHandle(subscriber_actor);
+    }
 }
 
 void Subscription::Callback(const luabridge::LuaRef& event_object) {
@@ -57,11 +64,11 @@ void EventBus::ProcessSubscriptions() {
     subscription_tasks.clear();
 }
 
-void EventBus::Publish(std::string event_type) {
+void EventBus::Publish(Atom event_type) {
     Publish(event_type, luabridge::LuaRef(ComponentManager::GetLuaState()));
 }
 
-void EventBus::Publish(std::string event_type, const luabridge::LuaRef& event_object) {
+void EventBus::Publish(Atom event_type, const luabridge::LuaRef& event_object, uint64_t tag_mask) {
 
     auto subscriber_list = events.find(event_type);
 
@@ -73,26 +80,47 @@ void EventBus::Publish(std::string event_type, const luabridge::LuaRef& event_ob
             if ((*subscription->component)["enabled"].cast<bool>() == false) {
                 orphaned_subscriptions.emplace_back(subscription);
             }
+            else if (subscription->actor.generation == 0) {
+                // Not attached to an actor, only unfiltered publishes reach it
+                if (tag_mask == 0)
+                    subscription->Callback(event_object);
+            }
             else {
-                subscription->Callback(event_object);
+                // Inactive actors don't receive events
+                Actor* subscriber_actor = subscription->actor.Get();
+                if (subscriber_actor == nullptr) {
+                    // Destroyed or back in its template's pool, a reused actor subscribes again in OnStart
+                    orphaned_subscriptions.emplace_back(subscription);
+                }
+                else if (subscriber_actor->active &&
+                    (tag_mask == 0 || (subscriber_actor->tag_mask & tag_mask) != 0))
+                    subscription->Callback(event_object);
             }
         }
 
         if (!orphaned_subscriptions.empty()) {
+            // Removed by pointer, a pooled actor's new subscription matches its old one's component and function
             for (Subscription* orphaned_subscription : orphaned_subscriptions) {
-                Unsubscribe(orphaned_subscription->event_type, *orphaned_subscription->component, *orphaned_subscription->function);
+                subscription_tasks.emplace_back(false, orphaned_subscription);
             }
         }
     }
 }
 
-void EventBus::Subscribe(std::string event_type, const luabridge::LuaRef& component, const luabridge::LuaRef& function) {
+int EventBus::SubscriberCount(Atom event_type) {
+    auto subscriber_list = events.find(event_type);
+    if (subscriber_list == events.end())
+        return 0;
+    return static_cast<int>(subscriber_list->second.size());
+}
+
+void EventBus::Subscribe(Atom event_type, const luabridge::LuaRef& component, const luabridge::LuaRef& function) {
     Subscription* subscription = new Subscription(event_type, component, function);
 
     subscription_tasks.emplace_back(true, subscription);
 }
 
-void EventBus::Unsubscribe(std::string event_type, const luabridge::LuaRef& component, const luabridge::LuaRef& function) {
+void EventBus::Unsubscribe(Atom event_type, const luabridge::LuaRef& component, const luabridge::LuaRef& function) {
     auto subscriber_list = events.find(event_type);
 
     if (subscriber_list != events.end() && !subscriber_list->second.empty()) {
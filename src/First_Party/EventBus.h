@@ -3,15 +3,19 @@
 #define EVENTBUS_H
 
 #include "utility.h"
+#include "Atom.h"
+#include "actor.h"
 #include <unordered_map>
 
 class Subscription {
 public:
-    std::string event_type;
+    Atom event_type;
     std::shared_ptr<luabridge::LuaRef> component;
     std::shared_ptr<luabridge::LuaRef> function;
+    // Actor of the subscribing component, for publishes filtered by tag
+    ActorHandle actor;
 
-    Subscription(std::string _event_type, const luabridge::LuaRef& _component, const luabridge::LuaRef& _function);
+    Subscription(Atom _event_type, const luabridge::LuaRef& _component, const luabridge::LuaRef& _function);
 
     void Callback(const luabridge::LuaRef& event_object);
 
@@ -21,12 +25,12 @@ public:
 class EventBus
 {
 public:
-    static inline std::unordered_map<std::string, std::vector<Subscription*>> events;
+    static inline ENGINE_THREAD_LOCAL std::unordered_map<Atom, std::vector<Subscription*>> events;
 
     //static inline std::unordered_map<Subscription*> already_subscribed;
 
     // Line of new subscribers (true) and unsubscribers (false)
-    static inline std::vector<std::pair<bool, Subscription*>> subscription_tasks;
+    static inline ENGINE_THREAD_LOCAL std::vector<std::pair<bool, Subscription*>> subscription_tasks;
 
     //static inline std::vector<Subscription*> new_subscribers;
 
@@ -34,13 +38,17 @@ public:
 
     static void ProcessSubscriptions();
 
-    static void Publish(std::string event_type);
+    static void Publish(Atom event_type);
 
-    static void Publish(std::string event_type, const luabridge::LuaRef& event_object);
+    // tag_mask != 0 only delivers to subscribers whose actor has at least one of the tags
+    static void Publish(Atom event_type, const luabridge::LuaRef& event_object, uint64_t tag_mask = 0);
 
-    static void Subscribe(std::string event_type, const luabridge::LuaRef& component, const luabridge::LuaRef& function);
+    // Subscriptions to event_type as of the last ProcessSubscriptions, including ones not yet cleaned up
+    static int SubscriberCount(Atom event_type);
 
-    static void Unsubscribe(std::string event_type, const luabridge::LuaRef& component, const luabridge::LuaRef& function);
+    static void Subscribe(Atom event_type, const luabridge::LuaRef& component, const luabridge::LuaRef& function);
+
+    static void Unsubscribe(Atom event_type, const luabridge::LuaRef& component, const luabridge::LuaRef& function);
 };
 
 #endif
\ No newline at end of file
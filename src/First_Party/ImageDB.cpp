@@ -111,7 +111,7 @@ void ImageDB::DrawUI(UIRenderRequest& request) {
 
 void ImageDB::CreateDefaultParticleTextureWithName(const std::string& name) {
 	// Have we already cached this default texture?
-	if (images.find(name) != images.end())
+	if (GameData::headless || images.find(name) != images.end())
 		return;
 	
 	// Create an SDL_Surface (a cpu-side texture) with no special flages, 8 width, 8 height, 32 bits of color depth (RGBA) and no masking.
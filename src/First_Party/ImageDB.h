@@ -16,11 +16,11 @@ struct ImageData {
 
 class ImageDB {
 public:
-    static inline std::unordered_map<std::string, ImageData*> images;
+    static inline ENGINE_THREAD_LOCAL std::unordered_map<std::string, ImageData*> images;
 
-    static inline SDL_Renderer* renderer = nullptr;
+    static inline ENGINE_THREAD_LOCAL SDL_Renderer* renderer = nullptr;
 
-    static inline glm::ivec2 cam_dimensions = glm::ivec2(0, 0);
+    static inline ENGINE_THREAD_LOCAL glm::ivec2 cam_dimensions = glm::ivec2(0, 0);
 
     static inline const int pixels_per_meter = 100;
 
@@ -100,16 +100,16 @@ public:
 
 
 private:
-    static inline std::unordered_map<SDL_Scancode, INPUT_STATE> keyboard_states;
-    static inline std::vector<SDL_Scancode> just_became_down_scancodes;
-    static inline std::vector<SDL_Scancode> just_became_up_scancodes;
+    static inline ENGINE_THREAD_LOCAL std::unordered_map<SDL_Scancode, INPUT_STATE> keyboard_states;
+    static inline ENGINE_THREAD_LOCAL std::vector<SDL_Scancode> just_became_down_scancodes;
+    static inline ENGINE_THREAD_LOCAL std::vector<SDL_Scancode> just_became_up_scancodes;
 
-    static inline glm::vec2 mouse_position;
-    static inline std::unordered_map<Uint8, INPUT_STATE> mouse_states;
-    static inline std::vector<Uint8> just_became_down_mouse_buttons;
-    static inline std::vector<Uint8> just_became_up_mouse_buttons;
+    static inline ENGINE_THREAD_LOCAL glm::vec2 mouse_position;
+    static inline ENGINE_THREAD_LOCAL std::unordered_map<Uint8, INPUT_STATE> mouse_states;
+    static inline ENGINE_THREAD_LOCAL std::vector<Uint8> just_became_down_mouse_buttons;
+    static inline ENGINE_THREAD_LOCAL std::vector<Uint8> just_became_up_mouse_buttons;
 
-    static inline float mouse_scroll_this_frame = 0;
+    static inline ENGINE_THREAD_LOCAL float mouse_scroll_this_frame = 0;
 
 	// string to keycode mapper
 	const static inline std::unordered_map<std::string, SDL_Scancode> __keycode_to_scancode = {
@@ -188,17 +188,17 @@ private:
 		{"'", SDL_SCANCODE_APOSTROPHE}
 	};
 
-	static inline std::unordered_map<SDL_JoystickID, Controller> controllers;
+	static inline ENGINE_THREAD_LOCAL std::unordered_map<SDL_JoystickID, Controller> controllers;
 
 	// This is the queue of controllers that are connected, but haven't been attached to a player
-	static inline std::queue<SDL_JoystickID> unconnected_controller_ids;
+	static inline ENGINE_THREAD_LOCAL std::queue<SDL_JoystickID> unconnected_controller_ids;
 
 	// This is the queue of controller ids that have been freed because the controllers disconnected
 	//static inline std::queue<SDL_JoystickID> disconnected_controller_ids;
-	static inline std::unordered_map<int, SDL_JoystickID> players;
+	static inline ENGINE_THREAD_LOCAL std::unordered_map<int, SDL_JoystickID> players;
 
-	static inline std::vector<SDL_JoystickID> just_became_down_controllers;
-	static inline std::vector<SDL_JoystickID> just_became_up_controllers;
+	static inline ENGINE_THREAD_LOCAL std::vector<SDL_JoystickID> just_became_down_controllers;
+	static inline ENGINE_THREAD_LOCAL std::vector<SDL_JoystickID> just_became_up_controllers;
 
 	// string to game controller button mapper
 	const static inline std::unordered_map<std::string, SDL_GameControllerButton> __buttonname_to_gamecontrollerbutton = {
@@ -0,0 +1,48 @@
+#include "NativeComponent.h"
+
+NativeComponentType* NativeComponentRegistry::Find(Atom type_id) {
+	auto it = types.find(type_id);
+	if (it == types.end())
+		return nullptr;
+
+	return &it->second;
+}
+
+int NativeComponentType::FindField(Atom field_name) const {
+	auto it = field_indices.find(field_name);
+	if (it == field_indices.end())
+		return -1;
+
+	return it->second;
+}
+
+luabridge::LuaRef NativeComponentRegistry::GetLuaRef(const void* instance) {
+	auto it = components_by_instance.find(instance);
+	if (it == components_by_instance.end())
+		return luabridge::LuaRef(ComponentManager::GetLuaState());
+
+	return *it->second->componentRef;
+}
+
+void NativeLuaGuard::Attach(lua_State* lua_state, void* instance, void (*reclaim)(void* instance)) {
+	NativeLuaGuard* guard = static_cast<NativeLuaGuard*>(lua_newuserdatauv(lua_state, sizeof(NativeLuaGuard), 0));
+	guard->instance = instance;
+	guard->reclaim = reclaim;
+
+	if (luaL_newmetatable(lua_state, "NativeLuaGuard")) {
+		lua_pushcfunction(lua_state, &NativeLuaGuard::GarbageCollect);
+		lua_setfield(lua_state, -2, "__gc");
+	}
+	lua_setmetatable(lua_state, -2);
+
+	lua_setiuservalue(lua_state, -2, 1);
+}
+
+int NativeLuaGuard::GarbageCollect(lua_State* lua_state) {
+	NativeLuaGuard* guard = static_cast<NativeLuaGuard*>(lua_touserdata(lua_state, 1));
+	if (guard->instance != nullptr)
+		guard->reclaim(guard->instance);
+	guard->instance = nullptr;
+
+	return 0;
+}
\ No newline at end of file
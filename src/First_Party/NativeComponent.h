@@ -0,0 +1,318 @@
+#pragma once
+#ifndef NATIVECOMPONENT_H
+#define NATIVECOMPONENT_H
+
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "utility.h"
+#include "ComponentManager.h"
+
+class Actor;
+
+// Lifecycle detection, a native type gets a has* flag for each of these it declares
+template <typename T, typename = void>
+struct NativeHasOnStart : std::false_type {};
+template <typename T>
+struct NativeHasOnStart<T, std::void_t<decltype(&T::OnStart)>> : std::true_type {};
+
+template <typename T, typename = void>
+struct NativeHasOnUpdate : std::false_type {};
+template <typename T>
+struct NativeHasOnUpdate<T, std::void_t<decltype(&T::OnUpdate)>> : std::true_type {};
+
+template <typename T, typename = void>
+struct NativeHasOnLateUpdate : std::false_type {};
+template <typename T>
+struct NativeHasOnLateUpdate<T, std::void_t<decltype(&T::OnLateUpdate)>> : std::true_type {};
+
+template <typename T, typename = void>
+struct NativeHasOnDestroy : std::false_type {};
+template <typename T>
+struct NativeHasOnDestroy<T, std::void_t<decltype(&T::OnDestroy)>> : std::true_type {};
+
+template <typename T, typename = void>
+struct NativeHasOnEnable : std::false_type {};
+template <typename T>
+struct NativeHasOnEnable<T, std::void_t<decltype(&T::OnEnable)>> : std::true_type {};
+
+template <typename T, typename = void>
+struct NativeHasOnDisable : std::false_type {};
+template <typename T>
+struct NativeHasOnDisable<T, std::void_t<decltype(&T::OnDisable)>> : std::true_type {};
+
+// Types with Reset(T* other) are reset in place when a pooled actor is recycled,
+// anything else is rebuilt from the template instance
+template <typename T, typename = void>
+struct NativeHasReset : std::false_type {};
+template <typename T>
+struct NativeHasReset<T, std::void_t<decltype(&T::Reset)>> : std::true_type {};
+
+// Json readers for reflected fields, values of the wrong type are ignored like schema fields
+inline void NativeReadJson(const rapidjson::Value& value, float& out) { if (value.IsNumber()) out = value.GetFloat(); }
+inline void NativeReadJson(const rapidjson::Value& value, int& out) { if (value.IsNumber()) out = static_cast<int>(value.GetDouble()); }
+inline void NativeReadJson(const rapidjson::Value& value, uint8_t& out) { if (value.IsNumber()) out = static_cast<uint8_t>(value.GetDouble()); }
+inline void NativeReadJson(const rapidjson::Value& value, bool& out) { if (value.IsBool()) out = value.GetBool(); }
+inline void NativeReadJson(const rapidjson::Value& value, std::string& out) { if (value.IsString()) out = value.GetString(); }
+
+// One reflected field of a native type. The member (or getter/setter pair) is a template
+// argument of both functions, so reading and copying it compiles down to a direct access.
+class NativeField {
+public:
+	void (*set_from_json)(void* instance, const rapidjson::Value& value) = nullptr;
+	void (*copy)(void* instance, const void* other) = nullptr;
+};
+
+// Everything the engine needs to know about a C++ component type, filled in by RegisterNativeComponent
+class NativeComponentType {
+public:
+	std::string name;
+	Atom type_id;
+
+	bool hasStart = false;
+	bool hasUpdate = false;
+	bool hasLateUpdate = false;
+	bool hasOnDestroy = false;
+	bool hasOnEnable = false;
+	bool hasOnDisable = false;
+
+	// Called directly by actors and scenes, the lua binding of the same methods is only for scripts.
+	// nullptr for callbacks the type doesn't declare.
+	void (*lifecycle[COMPONENT_LIFECYCLE_COUNT])(void* instance) = {};
+
+	bool (*is_enabled)(void* instance) = nullptr;
+	void (*set_enabled)(void* instance, bool enabled) = nullptr;
+
+	// Attaches the instance to its actor: sets key, actor and enabled = true without going through lua
+	void (*bind)(void* instance, Actor* actor, const std::string& key) = nullptr;
+
+	// Puts instance back to the values of template_instance
+	void (*reset)(void* instance, void* template_instance) = nullptr;
+
+	// A default instance / a copy of other's instance, wrapped in a pooled Component
+	Component* (*create)(NativeComponentType& native_type) = nullptr;
+	Component* (*clone)(NativeComponentType& native_type, Component* other) = nullptr;
+
+	// Tears the instance down when its Component is released. Scripts may still hold its userdata,
+	// so the slot keeps an inert default instance until lua collects it, see NativeLuaGuard.
+	void (*release)(void* instance) = nullptr;
+
+	// Fields scene and template files can set, declared with the NativeFieldList returned by RegisterNativeComponent
+	std::vector<NativeField> fields;
+	std::unordered_map<Atom, int> field_indices;
+
+	// -1 if the type doesn't reflect field_name
+	int FindField(Atom field_name) const;
+};
+
+// Builds a native type's field table, chained like the lua bindings:
+//   RegisterNativeComponent<Timer>("Timer").Field<&Timer::interval>("interval");
+template <typename T>
+class NativeFieldList {
+public:
+	explicit NativeFieldList(NativeComponentType& _native_type) : native_type(_native_type) {}
+
+	// A public data member, read from json as the member's own type
+	template <auto Member>
+	NativeFieldList& Field(const std::string& name) {
+		NativeField field;
+		field.set_from_json = [](void* instance, const rapidjson::Value& value) {
+			NativeReadJson(value, static_cast<T*>(instance)->*Member);
+		};
+		field.copy = [](void* instance, const void* other) {
+			static_cast<T*>(instance)->*Member = static_cast<const T*>(other)->*Member;
+		};
+		return Add(name, field);
+	}
+
+	// A value behind a getter and setter, for types that keep their state outside the instance
+	template <auto Getter, auto Setter>
+	NativeFieldList& Property(const std::string& name) {
+		NativeField field;
+		field.set_from_json = [](void* instance, const rapidjson::Value& value) {
+			T* object = static_cast<T*>(instance);
+			auto current = (object->*Getter)();
+			NativeReadJson(value, current);
+			(object->*Setter)(current);
+		};
+		field.copy = [](void* instance, const void* other) {
+			(static_cast<T*>(instance)->*Setter)((static_cast<const T*>(other)->*Getter)());
+		};
+		return Add(name, field);
+	}
+
+private:
+	NativeFieldList& Add(const std::string& name, const NativeField& field) {
+		native_type.field_indices[Atom(name)] = static_cast<int>(native_type.fields.size());
+		native_type.fields.push_back(field);
+		return *this;
+	}
+
+	NativeComponentType& native_type;
+};
+
+// Set as the user value of a native instance's userdata, so it is collected together with it.
+// Its finalizer gives the instance's slot back to the pool, a released instance's slot is never
+// reused while a script can still reach it.
+class NativeLuaGuard {
+public:
+	void* instance = nullptr;
+	void (*reclaim)(void* instance) = nullptr;
+
+	// Ties a new guard to the userdata on top of the stack
+	static void Attach(lua_State* lua_state, void* instance, void (*reclaim)(void* instance));
+
+	static int GarbageCollect(lua_State* lua_state);
+};
+
+class NativeComponentRegistry
+{
+public:
+	static inline ENGINE_THREAD_LOCAL std::unordered_map<Atom, NativeComponentType> types;
+
+	// Every live instance of T, in chunks of contiguous slots. Instances never move,
+	// so lua can keep pointing at them.
+	template <typename T>
+	static inline ENGINE_THREAD_LOCAL SlabPool<T> instances;
+
+	// The Component wrapping each live instance
+	static inline ENGINE_THREAD_LOCAL std::unordered_map<const void*, Component*> components_by_instance;
+
+	// Set when T is registered
+	template <typename T>
+	static inline ENGINE_THREAD_LOCAL NativeComponentType* type_of = nullptr;
+
+	// Public method to access the single instance of the class
+	static NativeComponentRegistry& getInstance() {
+		static NativeComponentRegistry instance; // Guaranteed to be created only once
+		return instance;
+	}
+
+	// T needs public type/key/actor/enabled fields, a default constructor and a
+	// T(T* other) copy constructor, and must already be bound to lua as a class.
+	// Chain the fields json can set onto the returned list.
+	template <typename T>
+	static NativeFieldList<T> RegisterNativeComponent(const std::string& name) {
+		NativeComponentType& native_type = types[Atom(name)];
+		native_type.name = name;
+		native_type.type_id = name;
+		native_type.fields.clear();
+		native_type.field_indices.clear();
+		type_of<T> = &native_type;
+
+		native_type.hasStart = NativeHasOnStart<T>::value;
+		native_type.hasUpdate = NativeHasOnUpdate<T>::value;
+		native_type.hasLateUpdate = NativeHasOnLateUpdate<T>::value;
+		native_type.hasOnDestroy = NativeHasOnDestroy<T>::value;
+		native_type.hasOnEnable = NativeHasOnEnable<T>::value;
+		native_type.hasOnDisable = NativeHasOnDisable<T>::value;
+
+		if constexpr (NativeHasOnStart<T>::value)
+			native_type.lifecycle[COMPONENT_LIFECYCLE_START] = [](void* instance) { static_cast<T*>(instance)->OnStart(); };
+		if constexpr (NativeHasOnUpdate<T>::value)
+			native_type.lifecycle[COMPONENT_LIFECYCLE_UPDATE] = [](void* instance) { static_cast<T*>(instance)->OnUpdate(); };
+		if constexpr (NativeHasOnLateUpdate<T>::value)
+			native_type.lifecycle[COMPONENT_LIFECYCLE_LATE_UPDATE] = [](void* instance) { static_cast<T*>(instance)->OnLateUpdate(); };
+		if constexpr (NativeHasOnDestroy<T>::value)
+			native_type.lifecycle[COMPONENT_LIFECYCLE_DESTROY] = [](void* instance) { static_cast<T*>(instance)->OnDestroy(); };
+		if constexpr (NativeHasOnEnable<T>::value)
+			native_type.lifecycle[COMPONENT_LIFECYCLE_ENABLE] = [](void* instance) { static_cast<T*>(instance)->OnEnable(); };
+		if constexpr (NativeHasOnDisable<T>::value)
+			native_type.lifecycle[COMPONENT_LIFECYCLE_DISABLE] = [](void* instance) { static_cast<T*>(instance)->OnDisable(); };
+
+		native_type.is_enabled = [](void* instance) { return static_cast<T*>(instance)->enabled; };
+		native_type.set_enabled = [](void* instance, bool enabled) { static_cast<T*>(instance)->enabled = enabled; };
+		native_type.bind = [](void* instance, Actor* actor, const std::string& key) {
+			T* object = static_cast<T*>(instance);
+			object->key = key;
+			object->actor = actor;
+			object->enabled = true;
+		};
+
+		native_type.reset = [](void* instance, void* template_instance) {
+			T* object = static_cast<T*>(instance);
+			if constexpr (NativeHasReset<T>::value) {
+				object->Reset(static_cast<T*>(template_instance));
+			}
+			else {
+				// Rebuilt at the same address, lua's userdata keeps pointing at it
+				object->~T();
+				new (object) T(static_cast<T*>(template_instance));
+			}
+		};
+
+		native_type.create = [](NativeComponentType& type) {
+			return Wrap<T>(type, instances<T>.Create());
+		};
+		native_type.clone = [](NativeComponentType& type, Component* other) {
+			T* other_instance = static_cast<T*>(other->native_instance);
+			T* instance = instances<T>.Create(other_instance);
+			instance->key = other_instance->key;
+			return Wrap<T>(type, instance);
+		};
+		native_type.release = [](void* instance) {
+			instances<T>.Retire(static_cast<T*>(instance));
+		};
+
+		return NativeFieldList<T>(native_type);
+	}
+
+	// Copies every reflected field of other, for T(T* other) constructors and Reset
+	template <typename T>
+	static void CopyFields(T* instance, const T* other) {
+		for (const NativeField& field : type_of<T>->fields)
+			field.copy(instance, other);
+	}
+
+	// nullptr if no native component is registered under type_id
+	static NativeComponentType* Find(Atom type_id);
+
+	// The userdata scripts already hold for instance, nil if it isn't a live native component.
+	// Native instances go to lua through this rather than as raw pointers, so each has exactly one userdata.
+	static luabridge::LuaRef GetLuaRef(const void* instance);
+
+	// Visit every live T without going through actors
+	template <typename T, typename Func>
+	static void ForEach(Func&& func) {
+		instances<T>.ForEach(std::forward<Func>(func));
+	}
+
+private:
+	template <typename T>
+	static Component* Wrap(NativeComponentType& native_type, T* instance) {
+		lua_State* lua_state = ComponentManager::GetLuaState();
+		Component* component = ComponentManager::component_pool.Create();
+
+		luabridge::Stack<T*>::push(lua_state, instance);
+		NativeLuaGuard::Attach(lua_state, instance, [](void* released) {
+			instances<T>.Reclaim(static_cast<T*>(released));
+		});
+		component->componentRef = std::make_shared<luabridge::LuaRef>(luabridge::LuaRef::fromStack(lua_state));
+		components_by_instance[instance] = component;
+
+		instance->enabled = true;
+		component->type = native_type.name;
+		component->type_id = native_type.type_id;
+		component->isCPPComponent = true;
+		component->native_type = &native_type;
+		component->native_instance = instance;
+		ComponentManager::IndexComponent(component);
+		component->hasStart = native_type.hasStart;
+		component->hasUpdate = native_type.hasUpdate;
+		component->hasLateUpdate = native_type.hasLateUpdate;
+		component->hasOnDestroy = native_type.hasOnDestroy;
+		component->hasOnEnable = native_type.hasOnEnable;
+		component->hasOnDisable = native_type.hasOnDisable;
+		return component;
+	}
+
+	// Private constructor and destructor to prevent multiple instances
+	NativeComponentRegistry() {}
+	~NativeComponentRegistry() = default;
+
+	// Delete copy constructor and assignment operator to prevent copying
+	NativeComponentRegistry(const NativeComponentRegistry&) = delete;
+	NativeComponentRegistry& operator=(const NativeComponentRegistry&) = delete;
+};
+
+#endif
\ No newline at end of file
@@ -1,44 +1,15 @@
 #include "ParticleSystem.h"
 #include "ImageDB.h"
 #include "renderer.h"
+#include "Transform.h"
+#include "NativeComponent.h"
 
 ParticleSystem::ParticleSystem() {
 
 }
 
 ParticleSystem::ParticleSystem(ParticleSystem* other) {
-	emit_angle_min = other->emit_angle_min;
-	emit_angle_max = other->emit_angle_max;
-	emit_radius_min = other->emit_radius_min;
-	emit_radius_max = other->emit_radius_max;
-	rotation_min = other->rotation_min;
-	rotation_max = other->rotation_max;
-	start_scale_min = other->start_scale_min;
-	start_scale_max = other->start_scale_max;
-	start_speed_min = other->start_speed_min;
-	start_speed_max = other->start_speed_max;
-	rotation_speed_min = other->rotation_speed_min;
-	rotation_speed_max = other->rotation_speed_max;
-	x = other->x;
-	y = other->y;
-	frames_between_bursts = other->frames_between_bursts;
-	burst_quantity = other->burst_quantity;
-	start_color_r = other->start_color_r;
-	start_color_g = other->start_color_g;
-	start_color_b = other->start_color_b;
-	start_color_a = other->start_color_a;
-	end_color_r = other->end_color_r;
-	end_color_g = other->end_color_g;
-	end_color_b = other->end_color_b;
-	end_color_a = other->end_color_a;
-	image = other->image;
-	sorting_order = other->sorting_order;
-	duration_frames = other->duration_frames;
-	gravity_scale_x = other->gravity_scale_x;
-	gravity_scale_y = other->gravity_scale_y;
-	drag_factor = other->drag_factor;
-	angular_drag_factor = other->angular_drag_factor;
-	end_scale = other->end_scale;
+	NativeComponentRegistry::CopyFields(this, other);
 }
 
 void ParticleSystem::OnStart() {
@@ -124,6 +95,15 @@ void ParticleSystem::GenerateNewParticles(int quantity) {
 
 	//existing_particles[local_frame_number] = start_index;
 
+	// With a Transform on the actor, x and y are relative to it
+	float origin_x = x;
+	float origin_y = y;
+	if (actor != nullptr && actor->transform != nullptr) {
+		b2Vec2 world_position = actor->transform->GetWorldPosition();
+		origin_x += world_position.x;
+		origin_y += world_position.y;
+	}
+
 	for (int i = 0; i < quantity; i++) {
 		float angle_radians = glm::radians(emit_angle_distribution.Sample());
 		float radius = emit_radius_distribution.Sample();
@@ -131,7 +111,7 @@ void ParticleSystem::GenerateNewParticles(int quantity) {
 		float cos_angle = glm::cos(angle_radians);
 		float sin_angle = glm::sin(angle_radians);
 
-		particle_positions[start_index + i] = { x + cos_angle * radius, y +  sin_angle * radius };
+		particle_positions[start_index + i] = { origin_x + cos_angle * radius, origin_y + sin_angle * radius };
 
 		float speed = speed_distribution.Sample();
 
@@ -1,6 +1,7 @@
 #include "Raycast.h"
 #include "ComponentManager.h"
 #include "Rigidbody.h"
+#include "TagDB.h"
 
 float RaycastCallback::ReportFixture(b2Fixture* fixture, 
 	const b2Vec2& point, const b2Vec2& normal, float fraction) {
@@ -10,6 +11,9 @@ float RaycastCallback::ReportFixture(b2Fixture* fixture,
 	if (Physics::hitResult.actor == nullptr || fixture->GetFilterData().categoryBits == 0x0003)
 		return -1.0f;
 
+	if (Physics::tag_filter != 0 && (Physics::hitResult.actor->tag_mask & Physics::tag_filter) == 0)
+		return -1.0f;
+
 	Physics::hitSomething = true;
 	Physics::hitResult.point = point;
 	Physics::hitResult.normal = normal;
@@ -26,6 +30,9 @@ float RaycastAllCallback::ReportFixture(b2Fixture* fixture,
 	if (actor == nullptr || fixture->GetFilterData().categoryBits == 0x0003)
 		return -1.0f;
 
+	if (Physics::tag_filter != 0 && (actor->tag_mask & Physics::tag_filter) == 0)
+		return -1.0f;
+
 	HitResult hit;
 	hit.actor = actor;
 	hit.point = point;
@@ -36,13 +43,14 @@ float RaycastAllCallback::ReportFixture(b2Fixture* fixture,
 	return 1.0f; // Return this to continue looking for things along the raycast
 }
 
-luabridge::LuaRef Physics::PhysicsRaycast(const b2Vec2& pos, const b2Vec2& dir, const float dist) {
+luabridge::LuaRef Physics::PhysicsRaycast(const b2Vec2& pos, const b2Vec2& dir, const float dist, const luabridge::LuaRef& tags) {
 	if (dist <= 0 || !Rigidbody::world_initialized) 
 		return luabridge::LuaRef(ComponentManager::GetLuaState());  // Return nil if invalid
 	
 	b2Vec2 end = pos + dist * dir;
 	RaycastCallback callback;
 	hitSomething = false;
+	tag_filter = TagDB::MaskFromLua(tags);
 	Rigidbody::world->RayCast(&callback, pos, end);
 
 	if (!hitSomething) {
@@ -52,13 +60,14 @@ luabridge::LuaRef Physics::PhysicsRaycast(const b2Vec2& pos, const b2Vec2& dir,
 	return luabridge::LuaRef(ComponentManager::GetLuaState(), hitResult);
 }
 
-luabridge::LuaRef Physics::PhysicsRaycastAll(const b2Vec2& pos, const b2Vec2& dir, const float dist) {
+luabridge::LuaRef Physics::PhysicsRaycastAll(const b2Vec2& pos, const b2Vec2& dir, const float dist, const luabridge::LuaRef& tags) {
 	if (dist <= 0 || !Rigidbody::world_initialized)
 		return luabridge::LuaRef(luabridge::newTable(ComponentManager::GetLuaState()));  // Return nil if invalid
 
 	b2Vec2 end = pos + dist * dir;
 	RaycastAllCallback callback;
 	hitResults.clear();
+	tag_filter = TagDB::MaskFromLua(tags);
 	Rigidbody::world->RayCast(&callback, pos, end);
 
 	if (hitResults.empty())
@@ -27,13 +27,17 @@ public:
 class Physics
 {
 public:
-	static inline bool hitSomething = false;
-	static inline HitResult hitResult;
-	static inline std::vector<HitResult> hitResults;
+	static inline ENGINE_THREAD_LOCAL bool hitSomething = false;
+	static inline ENGINE_THREAD_LOCAL HitResult hitResult;
+	static inline ENGINE_THREAD_LOCAL std::vector<HitResult> hitResults;
 
-	static luabridge::LuaRef PhysicsRaycast(const b2Vec2& pos, const b2Vec2& dir, const float dist);
+	// Hits are only reported on actors with one of these tags, 0 for any actor
+	static inline ENGINE_THREAD_LOCAL uint64_t tag_filter = 0;
 
-	static luabridge::LuaRef PhysicsRaycastAll(const b2Vec2& pos, const b2Vec2& dir, const float dist);
+	// tags is optional, a mask or tag name(s) the hit actor needs one of
+	static luabridge::LuaRef PhysicsRaycast(const b2Vec2& pos, const b2Vec2& dir, const float dist, const luabridge::LuaRef& tags);
+
+	static luabridge::LuaRef PhysicsRaycastAll(const b2Vec2& pos, const b2Vec2& dir, const float dist, const luabridge::LuaRef& tags);
 };
 
 #endif
@@ -1,4 +1,6 @@
 #include "Rigidbody.h"
+#include "Transform.h"
+#include "NativeComponent.h"
 
 void ContactListener::BeginContact(b2Contact* contact) {
 	b2Fixture* fixtureA = contact->GetFixtureA();
@@ -6,27 +8,39 @@ void ContactListener::BeginContact(b2Contact* contact) {
 	b2Fixture* fixtureB = contact->GetFixtureB();
 	Actor* actorB = reinterpret_cast<Actor*>(fixtureB->GetUserData().pointer);
 
-	Collision* collision = new Collision();
-	collision->other = actorB;
+	if (actorA == nullptr || actorB == nullptr)
+		return;
+
+	bool trigger = fixtureA->IsSensor() && fixtureB->IsSensor();
+	if (!trigger && (fixtureA->IsSensor() || fixtureB->IsSensor()))
+		return;
 
-	b2WorldManifold world_manifold;
-	contact->GetWorldManifold(&world_manifold);
-	collision->point = world_manifold.points[0];
-	collision->relative_velocity = fixtureA->GetBody()->GetLinearVelocity() - 
+	// Skip contacts between actors that have nothing listening before building a Collision
+	COLLISION_CALLBACK callback = trigger ? COLLISION_CALLBACK_TRIGGER_ENTER : COLLISION_CALLBACK_COLLISION_ENTER;
+	if (!actorA->HasCollisionListener(callback) && !actorB->HasCollisionListener(callback))
+		return;
+
+	Collision collision;
+	collision.other = actorB;
+	collision.relative_velocity = fixtureA->GetBody()->GetLinearVelocity() - 
 		fixtureB->GetBody()->GetLinearVelocity();
-	collision->normal = world_manifold.normal;
-
-	if (fixtureA->IsSensor() && fixtureB->IsSensor()) {
-		collision->point = b2Vec2(-999.0f, -999.0f);
-		collision->normal = b2Vec2(-999.0f, -999.0f);
-		actorA->OnTriggerEnter(collision);
-		collision->other = actorA;
-		actorB->OnTriggerEnter(collision);
+
+	if (trigger) {
+		collision.point = b2Vec2(-999.0f, -999.0f);
+		collision.normal = b2Vec2(-999.0f, -999.0f);
+		actorA->OnTriggerEnter(&collision);
+		collision.other = actorA;
+		actorB->OnTriggerEnter(&collision);
 	}
-	else if (!fixtureA->IsSensor() && !fixtureB->IsSensor()) {
-		actorA->OnCollisionEnter(collision);
-		collision->other = actorA;
-		actorB->OnCollisionEnter(collision);
+	else {
+		b2WorldManifold world_manifold;
+		contact->GetWorldManifold(&world_manifold);
+		collision.point = world_manifold.points[0];
+		collision.normal = world_manifold.normal;
+
+		actorA->OnCollisionEnter(&collision);
+		collision.other = actorA;
+		actorB->OnCollisionEnter(&collision);
 	}
 }
 
@@ -36,23 +50,34 @@ void ContactListener::EndContact(b2Contact* contact) {
 	b2Fixture* fixtureB = contact->GetFixtureB();
 	Actor* actorB = reinterpret_cast<Actor*>(fixtureB->GetUserData().pointer);
 
-	Collision* collision = new Collision();
-	collision->other = actorB;
+	if (actorA == nullptr || actorB == nullptr)
+		return;
 
-	collision->relative_velocity = fixtureA->GetBody()->GetLinearVelocity() -
+	bool trigger = fixtureA->IsSensor() && fixtureB->IsSensor();
+	if (!trigger && (fixtureA->IsSensor() || fixtureB->IsSensor()))
+		return;
+
+	COLLISION_CALLBACK callback = trigger ? COLLISION_CALLBACK_TRIGGER_EXIT : COLLISION_CALLBACK_COLLISION_EXIT;
+	if (!actorA->HasCollisionListener(callback) && !actorB->HasCollisionListener(callback))
+		return;
+
+	Collision collision;
+	collision.other = actorB;
+
+	collision.relative_velocity = fixtureA->GetBody()->GetLinearVelocity() -
 		fixtureB->GetBody()->GetLinearVelocity();
-	collision->point = b2Vec2(-999.0f, -999.0f);
-	collision->normal = b2Vec2(-999.0f, -999.0f);
+	collision.point = b2Vec2(-999.0f, -999.0f);
+	collision.normal = b2Vec2(-999.0f, -999.0f);
 
-	if (fixtureA->IsSensor() && fixtureB->IsSensor()) {
-		actorA->OnTriggerExit(collision);
-		collision->other = actorA;
-		actorB->OnTriggerExit(collision);
+	if (trigger) {
+		actorA->OnTriggerExit(&collision);
+		collision.other = actorA;
+		actorB->OnTriggerExit(&collision);
 	}
-	else if (!fixtureA->IsSensor() && !fixtureB->IsSensor()) {
-		actorA->OnCollisionExit(collision);
-		collision->other = actorA;
-		actorB->OnCollisionExit(collision);
+	else {
+		actorA->OnCollisionExit(&collision);
+		collision.other = actorA;
+		actorB->OnCollisionExit(&collision);
 	}
 }
 
@@ -65,21 +90,14 @@ Rigidbody::Rigidbody() {
 Rigidbody::Rigidbody(Rigidbody* other) {
 	InitializeWorld();
 
-	// TODO: Overhaul this entirely
-	*this = *other;
 	body = nullptr;
-	/*
-	x = (*other->componentRef)["x"];
-	y = (*other->componentRef)["y"];
-	body_type = (*other->componentRef)["body_type"].tostring();
-	precise = (*other->componentRef)["precise"];
-	gravity_scale = (*other->componentRef)["gravity_scale"];
-	density = (*other->componentRef)["density"];
-	angular_friction = (*other->componentRef)["angular_friction"];
-	rotation = (*other->componentRef)["rotation"];
-	has_collider = (*other->componentRef)["has_collider"].cast<bool>();
-	has_trigger = (*other->componentRef)["has_trigger"].cast<bool>();
-	*/
+	NativeComponentRegistry::CopyFields(this, other);
+}
+
+void Rigidbody::Reset(Rigidbody* other) {
+	NativeComponentRegistry::CopyFields(this, other);
+	enabled = other->enabled;
+	reset_pending = true;
 }
 
 void Rigidbody::InitializeWorld() {
@@ -287,8 +305,68 @@ void Rigidbody::Step() {
 		return;
 
 	world->Step(1.0f / 60.0f, 8, 3);
+
+	// Bodies drive the Transform of their actor, unchanged ones don't dirty anything
+	NativeComponentRegistry::ForEach<Rigidbody>([](Rigidbody& rigidbody) {
+		if (rigidbody.switch_pending) {
+			rigidbody.switch_pending = false;
+			if (rigidbody.switch_to_enabled)
+				rigidbody.OnEnable();
+			else
+				rigidbody.OnDisable();
+		}
+
+		if (rigidbody.body == nullptr || !rigidbody.body->IsEnabled() || rigidbody.actor == nullptr)
+			return;
+
+		Transform* transform = rigidbody.actor->transform;
+		if (transform == nullptr)
+			return;
+
+		transform->SetWorldPosition(rigidbody.body->GetPosition());
+		transform->SetWorldRotation(rigidbody.RadiansToDegrees(rigidbody.body->GetAngle()));
+	});
 }
 
 void Rigidbody::OnDestroy() {
+	if (body == nullptr)
+		return;
+
 	world->DestroyBody(body);
+	body = nullptr;
+}
+
+void Rigidbody::OnEnable() {
+	if (world->IsLocked()) {
+		switch_pending = true;
+		switch_to_enabled = true;
+		return;
+	}
+
+	if (body == nullptr) {
+		OnStart();
+		return;
+	}
+
+	if (reset_pending) {
+		body->SetTransform(b2Vec2(x, y), DegreesToRadians(rotation));
+		body->SetLinearVelocity(b2Vec2(0.0f, 0.0f));
+		body->SetAngularVelocity(0.0f);
+		body->SetGravityScale(gravity_scale);
+		reset_pending = false;
+	}
+
+	body->SetEnabled(true);
+	body->SetAwake(true);
+}
+
+void Rigidbody::OnDisable() {
+	if (world->IsLocked()) {
+		switch_pending = true;
+		switch_to_enabled = false;
+		return;
+	}
+
+	if (body != nullptr)
+		body->SetEnabled(false);
 }
@@ -24,9 +24,9 @@ public:
 class Rigidbody
 {
 public:
-	static inline bool world_initialized = false;
-	static inline b2World* world = nullptr;
-	static inline ContactListener* contact_listener = nullptr;
+	static inline ENGINE_THREAD_LOCAL bool world_initialized = false;
+	static inline ENGINE_THREAD_LOCAL b2World* world = nullptr;
+	static inline ENGINE_THREAD_LOCAL ContactListener* contact_listener = nullptr;
 
 	std::string type = "Rigidbody";
 	std::string key = "???";
@@ -35,6 +35,14 @@ public:
 
 	b2Body* body;
 
+	// Set by Reset, the next OnEnable moves the body back to x/y/rotation and stops it
+	bool reset_pending = false;
+
+	// Box2D can't switch bodies while the world steps, an OnEnable/OnDisable from a collision
+	// callback is recorded here and applied by Step once world->Step returns
+	bool switch_pending = false;
+	bool switch_to_enabled = false;
+
 	float x = 0.0f;
 	float y = 0.0f;
 	std::string body_type = "dynamic";
@@ -68,6 +76,9 @@ public:
 
 	Rigidbody(Rigidbody* other);
 
+	// Copies other's settings but keeps this body, used when a pooled actor is recycled
+	void Reset(Rigidbody* other);
+
 	void InitializeWorld();
 
 	float DegreesToRadians(const float degrees);
@@ -114,6 +125,11 @@ public:
 	static void Step();
 
 	void OnDestroy();
+
+	// Inactive and pooled actors keep their body in the world, switched off
+	void OnEnable();
+
+	void OnDisable();
 };
 
 #endif
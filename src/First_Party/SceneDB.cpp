@@ -2,11 +2,10 @@
 
 Scene* SceneDB::LoadScene(std::string sceneName) {
 
-	// If the scene already exists, retrieve it and return
-	/*if (scenes.find(sceneName) != scenes.end()) {
-		Scene* scene = new Scene(*scenes[sceneName], sceneName);
-		return scene;
-	}*/
+	// If the scene was loaded before, copy it from its snapshot
+	auto snapshot = scenes.find(sceneName);
+	if (snapshot != scenes.end())
+		return new Scene(*snapshot->second, sceneName);
 
 	// Get the path of the current executable
 	//fs::path exePath = fs::current_path();
@@ -21,12 +20,10 @@ Scene* SceneDB::LoadScene(std::string sceneName) {
 	rapidjson::Document sceneDoc;
 	EngineUtils::ReadJsonFile(sceneDir.string(), sceneDoc);
 
-	Scene* scene = new Scene(sceneDoc, sceneName);
+	// The scene built from JSON is never started, it is kept as the level's initial state
+	// in case we ever come back and every load plays a copy of it
+	Scene* initial_scene = new Scene(sceneDoc, sceneName);
+	scenes[sceneName] = initial_scene;
 
-	//Scene* copyForCache = new Scene(*scene, sceneName);
-
-	// Store a copy of the level's initial state in case we ever come back
-	//scenes[sceneName] = scene;
-
-	return scene; 
+	return new Scene(*initial_scene, sceneName);
 }
\ No newline at end of file
@@ -12,7 +12,8 @@ namespace fs = std::filesystem;
 class SceneDB
 {
 public:
-	static inline std::unordered_map<std::string, Scene*> scenes;
+	// Snapshot of each loaded scene's initial state, never updated. Loads after the first copy from it.
+	static inline ENGINE_THREAD_LOCAL std::unordered_map<std::string, Scene*> scenes;
 
     // Public method to access the single instance of the class
     static SceneDB& getInstance() {
@@ -0,0 +1,148 @@
+#pragma once
+#ifndef SLABPOOL_H
+#define SLABPOOL_H
+
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Fixed-size chunks of T with a free list, so creating and destroying objects
+// reuses slots instead of going to the general heap. Objects never move once
+// created. Each slot has a generation that is bumped when its object is
+// released, so (index, generation) pairs can be checked for staleness in O(1).
+template <typename T, size_t ChunkSize = 64>
+class SlabPool
+{
+	struct Slot {
+		// storage must be the first member, objects are mapped back to their slot by address
+		alignas(T) unsigned char storage[sizeof(T)];
+		uint32_t index;
+		uint32_t generation;
+		bool alive;
+	};
+
+public:
+	SlabPool() = default;
+
+	SlabPool(const SlabPool&) = delete;
+	SlabPool& operator=(const SlabPool&) = delete;
+
+	template <typename... Args>
+	T* Create(Args&&... args) {
+		Slot* slot = AcquireSlot();
+
+		// Mark the slot live first so the object's constructor can already hand out handles to itself
+		slot->alive = true;
+		T* object = new (slot->storage) T(std::forward<Args>(args)...);
+		live_count++;
+
+		return object;
+	}
+
+	void Release(T* object) {
+		if (object == nullptr)
+			return;
+
+		Slot* slot = SlotOf(object);
+		if (!slot->alive)
+			return;
+
+		object->~T();
+		slot->alive = false;
+		slot->generation++;
+		live_count--;
+
+		free_slots.push_back(slot->index);
+	}
+
+	// Like Release, but leaves a default T in the slot and keeps the slot out of reuse until
+	// Reclaim. For objects something outside the pool may still point at for a while.
+	void Retire(T* object) {
+		if (object == nullptr)
+			return;
+
+		Slot* slot = SlotOf(object);
+		if (!slot->alive)
+			return;
+
+		object->~T();
+		new (slot->storage) T();
+		slot->alive = false;
+		slot->generation++;
+		live_count--;
+	}
+
+	// Frees a slot emptied by Retire
+	void Reclaim(T* object) {
+		Slot* slot = SlotOf(object);
+		if (slot->alive)
+			return;
+
+		object->~T();
+		free_slots.push_back(slot->index);
+	}
+
+	// Makes every existing handle to object stale without releasing it, for objects that are recycled in place
+	void Invalidate(T* object) {
+		SlotOf(object)->generation++;
+	}
+
+	// nullptr if the slot was released (or reused) since the handle was taken
+	T* Get(uint32_t index, uint32_t generation) {
+		if (index >= slot_count)
+			return nullptr;
+
+		Slot& slot = chunks[index / ChunkSize][index % ChunkSize];
+		if (!slot.alive || slot.generation != generation)
+			return nullptr;
+
+		return reinterpret_cast<T*>(slot.storage);
+	}
+
+	static uint32_t IndexOf(const T* object) { return SlotOf(object)->index; }
+
+	static uint32_t GenerationOf(const T* object) { return SlotOf(object)->generation; }
+
+	size_t Size() const { return live_count; }
+
+	// Visits every live object in slot order, a chunk at a time
+	template <typename Func>
+	void ForEach(Func&& func) {
+		for (uint32_t index = 0; index < slot_count; index++) {
+			Slot& slot = chunks[index / ChunkSize][index % ChunkSize];
+			if (slot.alive)
+				func(*reinterpret_cast<T*>(slot.storage));
+		}
+	}
+
+private:
+	std::vector<std::unique_ptr<Slot[]>> chunks;
+	std::vector<uint32_t> free_slots;
+	uint32_t slot_count = 0;
+	size_t live_count = 0;
+
+	static Slot* SlotOf(const T* object) {
+		return reinterpret_cast<Slot*>(const_cast<T*>(object));
+	}
+
+	Slot* AcquireSlot() {
+		if (!free_slots.empty()) {
+			uint32_t index = free_slots.back();
+			free_slots.pop_back();
+			return &chunks[index / ChunkSize][index % ChunkSize];
+		}
+
+		if (slot_count % ChunkSize == 0)
+			chunks.emplace_back(new Slot[ChunkSize]);
+
+		Slot* slot = &chunks.back()[slot_count % ChunkSize];
+		slot->index = slot_count++;
+		slot->generation = 1; // 0 is never a valid generation, default handles resolve to nothing
+		slot->alive = false;
+		return slot;
+	}
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,102 @@
+#pragma once
+#ifndef SMALLVECTOR_H
+#define SMALLVECTOR_H
+
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+// Vector of trivially copyable values (pointers, ints) that keeps the first N
+// elements inline and only touches the heap once it grows past them.
+// Actors usually have a handful of components, so their lists never allocate.
+template <typename T, size_t N>
+class SmallVector
+{
+	static_assert(std::is_trivially_copyable<T>::value, "SmallVector only holds trivially copyable values");
+
+public:
+	SmallVector() : elements(inline_elements), count(0), capacity(N) {}
+
+	SmallVector(const SmallVector& other) : SmallVector() {
+		Reserve(other.count);
+		std::memcpy(elements, other.elements, other.count * sizeof(T));
+		count = other.count;
+	}
+
+	SmallVector& operator=(const SmallVector& other) {
+		if (this != &other) {
+			count = 0;
+			Reserve(other.count);
+			std::memcpy(elements, other.elements, other.count * sizeof(T));
+			count = other.count;
+		}
+		return *this;
+	}
+
+	~SmallVector() {
+		if (elements != inline_elements)
+			std::free(elements);
+	}
+
+	T* begin() { return elements; }
+	T* end() { return elements + count; }
+	const T* begin() const { return elements; }
+	const T* end() const { return elements + count; }
+
+	T& operator[](size_t index) { return elements[index]; }
+	const T& operator[](size_t index) const { return elements[index]; }
+
+	T& back() { return elements[count - 1]; }
+
+	size_t size() const { return count; }
+	bool empty() const { return count == 0; }
+	void clear() { count = 0; }
+
+	void push_back(const T& value) {
+		if (count == capacity)
+			Reserve(capacity * 2);
+		elements[count++] = value;
+	}
+
+	void pop_back() { --count; }
+
+	// Shifts the tail up by one, returns the inserted position
+	T* insert(T* position, const T& value) {
+		size_t index = position - elements;
+		if (count == capacity)
+			Reserve(capacity * 2);
+		std::memmove(elements + index + 1, elements + index, (count - index) * sizeof(T));
+		elements[index] = value;
+		++count;
+		return elements + index;
+	}
+
+	// Shifts the tail down by one, keeps the order of the remaining elements
+	T* erase(T* position) {
+		size_t index = position - elements;
+		std::memmove(elements + index, elements + index + 1, (count - index - 1) * sizeof(T));
+		--count;
+		return elements + index;
+	}
+
+	void Reserve(size_t new_capacity) {
+		if (new_capacity <= capacity)
+			return;
+
+		T* new_elements = static_cast<T*>(std::malloc(new_capacity * sizeof(T)));
+		std::memcpy(new_elements, elements, count * sizeof(T));
+		if (elements != inline_elements)
+			std::free(elements);
+
+		elements = new_elements;
+		capacity = new_capacity;
+	}
+
+private:
+	T* elements;
+	size_t count;
+	size_t capacity;
+	T inline_elements[N];
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,166 @@
+#include "SpatialHash.h"
+#include "scene.h"
+#include "Rigidbody.h"
+#include "Transform.h"
+#include "NativeComponent.h"
+
+void SpatialHash::Build(Scene* scene) {
+	built_frame = GameData::GetFrameNumber();
+	build_count++;
+	cell_size = GameData::CELL_SIZE > 0.0f ? GameData::CELL_SIZE : 1.0f;
+
+	// Cells keep their storage between builds, only the entries are dropped
+	for (auto& cell : cells)
+		cell.second.clear();
+	occupied_cells = 0;
+	min_cell_x = min_cell_y = std::numeric_limits<int>::max();
+	max_cell_x = max_cell_y = std::numeric_limits<int>::min();
+
+	// Actors with a Transform are placed by it (Rigidbodies sync into it), the rest by their Rigidbody
+	NativeComponentRegistry::ForEach<Transform>([&](Transform& transform) {
+		Actor* actor = transform.actor;
+		if (actor == nullptr || actor->transform != &transform)
+			return;
+		Insert(scene, actor, transform.GetWorldPosition());
+	});
+
+	NativeComponentRegistry::ForEach<Rigidbody>([&](Rigidbody& rigidbody) {
+		if (rigidbody.actor != nullptr)
+			Insert(scene, rigidbody.actor, rigidbody.GetPosition());
+	});
+
+	// Drop cells that have been left behind by moving actors once they dominate the map
+	if (cells.size() > 64 && cells.size() > occupied_cells * 4) {
+		for (auto it = cells.begin(); it != cells.end();) {
+			if (it->second.empty())
+				it = cells.erase(it);
+			else
+				++it;
+		}
+	}
+}
+
+void SpatialHash::Insert(Scene* scene, Actor* actor, const b2Vec2& position) {
+	if (actor->scene != scene || actor->destroyed || !actor->active || actor->spatial_stamp == build_count)
+		return;
+	actor->spatial_stamp = build_count;
+
+	int cell_x = CellCoordinate(position.x);
+	int cell_y = CellCoordinate(position.y);
+
+	std::vector<SpatialEntry>& cell = cells[EngineUtils::CreateCompositeKey(cell_x, cell_y)];
+	if (cell.empty())
+		occupied_cells++;
+	cell.push_back({ actor, position.x, position.y });
+
+	min_cell_x = std::min(min_cell_x, cell_x);
+	min_cell_y = std::min(min_cell_y, cell_y);
+	max_cell_x = std::max(max_cell_x, cell_x);
+	max_cell_y = std::max(max_cell_y, cell_y);
+}
+
+bool SpatialHash::Matches(const SpatialEntry& entry, const SpatialFilter& filter) {
+	Actor* actor = entry.actor;
+	if (actor->destroyed)
+		return false;
+	if (filter.name.id != 0 && actor->name_id != filter.name)
+		return false;
+	return filter.tag_mask == 0 || (actor->tag_mask & filter.tag_mask) != 0;
+}
+
+void SpatialHash::QueryRadius(float x, float y, float radius, const SpatialFilter& filter, std::vector<SpatialEntry>& results) {
+	size_t first_result = results.size();
+	float radius_squared = radius * radius;
+
+	int first_x = std::max(CellCoordinate(x - radius), min_cell_x);
+	int last_x = std::min(CellCoordinate(x + radius), max_cell_x);
+	int first_y = std::max(CellCoordinate(y - radius), min_cell_y);
+	int last_y = std::min(CellCoordinate(y + radius), max_cell_y);
+
+	for (int cell_x = first_x; cell_x <= last_x; cell_x++) {
+		for (int cell_y = first_y; cell_y <= last_y; cell_y++) {
+			auto cell = cells.find(EngineUtils::CreateCompositeKey(cell_x, cell_y));
+			if (cell == cells.end())
+				continue;
+
+			for (const SpatialEntry& entry : cell->second) {
+				float dx = entry.x - x;
+				float dy = entry.y - y;
+				if (dx * dx + dy * dy <= radius_squared && Matches(entry, filter))
+					results.push_back(entry);
+			}
+		}
+	}
+
+	std::sort(results.begin() + first_result, results.end(), [x, y](const SpatialEntry& a, const SpatialEntry& b) {
+		return (a.x - x) * (a.x - x) + (a.y - y) * (a.y - y) < (b.x - x) * (b.x - x) + (b.y - y) * (b.y - y);
+	});
+}
+
+void SpatialHash::QueryRect(float min_x, float min_y, float max_x, float max_y, const SpatialFilter& filter, std::vector<SpatialEntry>& results) {
+	int first_x = std::max(CellCoordinate(min_x), min_cell_x);
+	int last_x = std::min(CellCoordinate(max_x), max_cell_x);
+	int first_y = std::max(CellCoordinate(min_y), min_cell_y);
+	int last_y = std::min(CellCoordinate(max_y), max_cell_y);
+
+	for (int cell_x = first_x; cell_x <= last_x; cell_x++) {
+		for (int cell_y = first_y; cell_y <= last_y; cell_y++) {
+			auto cell = cells.find(EngineUtils::CreateCompositeKey(cell_x, cell_y));
+			if (cell == cells.end())
+				continue;
+
+			for (const SpatialEntry& entry : cell->second) {
+				if (entry.x >= min_x && entry.x <= max_x && entry.y >= min_y && entry.y <= max_y && Matches(entry, filter))
+					results.push_back(entry);
+			}
+		}
+	}
+}
+
+Actor* SpatialHash::QueryNearest(float x, float y, float max_radius, const SpatialFilter& filter) {
+	if (occupied_cells == 0)
+		return nullptr;
+
+	int center_x = CellCoordinate(x);
+	int center_y = CellCoordinate(y);
+
+	// Every cell outside the occupied bounds is empty, so the search ends once a ring covers them
+	int max_ring = std::max({ std::abs(center_x - min_cell_x), std::abs(center_x - max_cell_x),
+		std::abs(center_y - min_cell_y), std::abs(center_y - max_cell_y) });
+	if (max_radius >= 0.0f)
+		max_ring = std::min(max_ring, static_cast<int>(std::ceil(max_radius / cell_size)));
+
+	Actor* nearest = nullptr;
+	float nearest_distance_squared = max_radius >= 0.0f ? max_radius * max_radius : std::numeric_limits<float>::max();
+
+	for (int ring = 0; ring <= max_ring; ring++) {
+		// Anything in this ring or beyond is at least (ring - 1) cells away
+		float ring_distance = (ring - 1) * cell_size;
+		if (nearest != nullptr && ring_distance > 0.0f && ring_distance * ring_distance > nearest_distance_squared)
+			break;
+
+		for (int cell_x = center_x - ring; cell_x <= center_x + ring; cell_x++) {
+			// Only the border of the ring, the inside was covered by earlier rings
+			bool edge_column = cell_x == center_x - ring || cell_x == center_x + ring;
+			int step = edge_column ? 1 : std::max(1, ring * 2);
+
+			for (int cell_y = center_y - ring; cell_y <= center_y + ring; cell_y += step) {
+				auto cell = cells.find(EngineUtils::CreateCompositeKey(cell_x, cell_y));
+				if (cell == cells.end())
+					continue;
+
+				for (const SpatialEntry& entry : cell->second) {
+					float dx = entry.x - x;
+					float dy = entry.y - y;
+					float distance_squared = dx * dx + dy * dy;
+					if (distance_squared <= nearest_distance_squared && Matches(entry, filter)) {
+						nearest = entry.actor;
+						nearest_distance_squared = distance_squared;
+					}
+				}
+			}
+		}
+	}
+
+	return nearest;
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+#ifndef SPATIALHASH_H
+#define SPATIALHASH_H
+
+#include <unordered_map>
+#include <vector>
+#include "utility.h"
+#include "gameData.h"
+#include "Atom.h"
+
+class Actor;
+class Scene;
+
+// Which actors a query returns, the default matches every actor
+class SpatialFilter {
+public:
+	Atom name;
+	// The actor needs at least one of these tags, 0 for any actor
+	uint64_t tag_mask = 0;
+};
+
+class SpatialEntry {
+public:
+	Actor* actor = nullptr;
+	float x = 0.0f;
+	float y = 0.0f;
+};
+
+// Uniform grid of the scene's actors, keyed by EngineUtils::CreateCompositeKey of the
+// cell coordinates. Positions come from each actor's Rigidbody. The grid is rebuilt
+// the first time it is queried in a frame, so frames without queries cost nothing.
+class SpatialHash
+{
+public:
+	// World units per cell, GameData::CELL_SIZE when the grid is built
+	float cell_size = 1.0f;
+
+	std::unordered_map<uint64_t, std::vector<SpatialEntry>> cells;
+	size_t occupied_cells = 0;
+
+	// Bounds of the occupied cells, queries never walk outside them
+	int min_cell_x = 0, min_cell_y = 0;
+	int max_cell_x = -1, max_cell_y = -1;
+
+	// Frame the grid was built on, -1 forces a rebuild on the next query
+	int built_frame = -1;
+
+	// Bumped every build, see Actor::spatial_stamp
+	static inline ENGINE_THREAD_LOCAL int build_count = 0;
+
+	void Refresh(Scene* scene) {
+		if (built_frame != GameData::GetFrameNumber())
+			Build(scene);
+	}
+
+	// Call when actors the grid may point at are freed
+	void Invalidate() { built_frame = -1; }
+
+	// Actors within radius of (x, y), nearest first
+	void QueryRadius(float x, float y, float radius, const SpatialFilter& filter, std::vector<SpatialEntry>& results);
+
+	void QueryRect(float min_x, float min_y, float max_x, float max_y, const SpatialFilter& filter, std::vector<SpatialEntry>& results);
+
+	// nullptr if nothing matches within max_radius
+	Actor* QueryNearest(float x, float y, float max_radius, const SpatialFilter& filter);
+
+private:
+	void Build(Scene* scene);
+
+	// Places actor once per build, skipping ones that aren't live in scene
+	void Insert(Scene* scene, Actor* actor, const b2Vec2& position);
+
+	int CellCoordinate(float position) const {
+		return static_cast<int>(std::floor(position / cell_size));
+	}
+
+	static bool Matches(const SpatialEntry& entry, const SpatialFilter& filter);
+};
+
+#endif
\ No newline at end of file
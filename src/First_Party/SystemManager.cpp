@@ -0,0 +1,105 @@
+#include "SystemManager.h"
+#include "ComponentManager.h"
+
+void SystemManager::Register(Atom type, const luabridge::LuaRef& function) {
+	if (!function.isFunction())
+		return;
+
+	// Registering the same pair again (from an OnStart that runs on every Scene.Load, say) is a no-op
+	for (System& system : systems) {
+		if (system.type == type && *system.function == function) {
+			system.removed = false;
+			return;
+		}
+	}
+
+	systems.emplace_back(type, function);
+}
+
+void SystemManager::Unregister(Atom type, const luabridge::LuaRef& function) {
+	for (System& system : systems) {
+		if (!system.removed && system.type == type && *system.function == function) {
+			// Removed systems are compacted after the current RunSystems pass
+			system.removed = true;
+			systems_dirty = true;
+			return;
+		}
+	}
+}
+
+void SystemManager::AddComponent(Component* component) {
+	if (component->system_index != -1)
+		return;
+
+	std::vector<Component*>& components = components_by_type[component->type_id];
+	component->system_index = static_cast<int>(components.size());
+	components.emplace_back(component);
+}
+
+void SystemManager::RemoveComponent(Component* component) {
+	if (component->system_index == -1)
+		return;
+
+	auto components_with_type = components_by_type.find(component->type_id);
+	if (components_with_type == components_by_type.end())
+		return;
+
+	std::vector<Component*>& components = components_with_type->second;
+
+	// Swap with the last component so removal is O(1)
+	Component* last = components.back();
+	components[component->system_index] = last;
+	last->system_index = component->system_index;
+	components.pop_back();
+
+	component->system_index = -1;
+}
+
+void SystemManager::RunSystems() {
+	if (systems.empty())
+		return;
+
+	lua_State* lua_state = ComponentManager::GetLuaState();
+
+	// Systems registered while running start on the next frame
+	size_t system_count = systems.size();
+
+	for (size_t i = 0; i < system_count; i++) {
+		if (systems[i].removed)
+			continue;
+
+		// Copy the function ref in case the system vector grows while it runs
+		std::shared_ptr<luabridge::LuaRef> function = systems[i].function;
+
+		auto components_with_type = components_by_type.find(systems[i].type);
+		int count = (components_with_type == components_by_type.end()) ? 0 : static_cast<int>(components_with_type->second.size());
+
+		// Build the array directly on the lua stack, pre-sized
+		lua_createtable(lua_state, count, 0);
+		int index = 1; // Lua tables are 1-based
+
+		for (int j = 0; j < count; j++) {
+			Component* component = components_with_type->second[j];
+			if (!component->IsEnabled())
+				continue;
+
+			component->componentRef->push(lua_state);
+			lua_rawseti(lua_state, -2, index++);
+		}
+
+		luabridge::LuaRef component_array = luabridge::LuaRef::fromStack(lua_state);
+
+		try {
+			(*function)(component_array);
+		}
+		catch (const luabridge::LuaException& e) {
+			EngineUtils::ReportError("System " + systems[i].type.str(), e);
+		}
+	}
+
+	if (systems_dirty) {
+		systems.erase(std::remove_if(systems.begin(), systems.end(),
+			[](const System& system) { return system.removed; }), systems.end());
+		systems_dirty = false;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+#ifndef SYSTEMMANAGER_H
+#define SYSTEMMANAGER_H
+
+#include <unordered_map>
+#include <vector>
+#include "utility.h"
+#include "Atom.h"
+
+class Component;
+
+// A Lua function that runs once per frame over every enabled component of a type
+class System {
+public:
+	Atom type;
+	std::shared_ptr<luabridge::LuaRef> function;
+	bool removed = false;
+
+	System(Atom _type, const luabridge::LuaRef& _function) :
+		type(_type), function(std::make_shared<luabridge::LuaRef>(_function)) {}
+};
+
+class SystemManager
+{
+public:
+	// Dense arrays of every live component, by component type. Components are
+	// added when their actor starts (or when they are added at runtime) and
+	// swap-removed when they are removed or their actor is destroyed.
+	static inline ENGINE_THREAD_LOCAL std::unordered_map<Atom, std::vector<Component*>> components_by_type;
+
+	static inline ENGINE_THREAD_LOCAL std::vector<System> systems;
+
+	// Public method to access the single instance of the class
+	static SystemManager& getInstance() {
+		static SystemManager instance; // Guaranteed to be created only once
+		return instance;
+	}
+
+	// System.Register(type, function): function(components) is called once per frame
+	// with an array of every enabled component of that type. A (type, function) pair is only registered once.
+	static void Register(Atom type, const luabridge::LuaRef& function);
+
+	static void Unregister(Atom type, const luabridge::LuaRef& function);
+
+	static void AddComponent(Component* component);
+
+	static void RemoveComponent(Component* component);
+
+	// Call every registered system, after actor OnUpdate and before OnLateUpdate
+	static void RunSystems();
+
+private:
+	static inline ENGINE_THREAD_LOCAL bool systems_dirty = false;
+
+	// Private constructor and destructor to prevent multiple instances
+	SystemManager() {}
+	~SystemManager() = default;
+
+	// Delete copy constructor and assignment operator to prevent copying
+	SystemManager(const SystemManager&) = delete;
+	SystemManager& operator=(const SystemManager&) = delete;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include "TagDB.h"
+
+int TagDB::GetBit(Atom tag) {
+	auto it = tag_bits.find(tag);
+	if (it != tag_bits.end())
+		return it->second;
+
+	if (static_cast<int>(tag_bits.size()) >= UNKNOWN_TAG_BIT) {
+		std::cout << "error: more than " << UNKNOWN_TAG_BIT << " tags, can't add tag " << tag.str();
+		exit(0);
+	}
+
+	int bit = static_cast<int>(tag_bits.size());
+	tag_bits[tag] = bit;
+	return bit;
+}
+
+uint64_t TagDB::FindMask(Atom tag) {
+	auto it = tag_bits.find(tag);
+	if (it == tag_bits.end())
+		return 0;
+	return uint64_t(1) << it->second;
+}
+
+static uint64_t FindLuaTagMask(const luabridge::LuaRef& tag) {
+	uint64_t mask = TagDB::FindMask(tag.cast<Atom>());
+	return mask != 0 ? mask : uint64_t(1) << TagDB::UNKNOWN_TAG_BIT;
+}
+
+uint64_t TagDB::MaskFromJson(const rapidjson::Value& value) {
+	if (value.IsString())
+		return GetMask(value.GetString());
+
+	uint64_t mask = 0;
+	if (value.IsArray()) {
+		for (const auto& tag : value.GetArray()) {
+			if (tag.IsString())
+				mask |= GetMask(tag.GetString());
+		}
+	}
+	return mask;
+}
+
+uint64_t TagDB::MaskFromLua(const luabridge::LuaRef& value) {
+	if (value.isNumber())
+		return static_cast<uint64_t>(value.cast<long long>());
+
+	if (value.isString())
+		return FindLuaTagMask(value);
+
+	uint64_t mask = 0;
+	if (value.isTable()) {
+		for (int i = 1; i <= value.length(); i++) {
+			luabridge::LuaRef tag = value[i];
+			if (tag.isString())
+				mask |= FindLuaTagMask(tag);
+		}
+	}
+	return mask;
+}
+
+long long TagDB::LuaMask(const luabridge::LuaRef& tags) {
+	return static_cast<long long>(MaskFromLua(tags));
+}
\ No newline at end of file
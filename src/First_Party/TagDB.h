@@ -0,0 +1,71 @@
+#pragma once
+#ifndef TAGDB_H
+#define TAGDB_H
+
+#include <unordered_map>
+#include <vector>
+#include "utility.h"
+#include "Atom.h"
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Tags are the bits of an actor's 64-bit tag mask. Each tag name is given the next
+// free bit the first time an actor gets it, from a scene, a template or AddTag.
+// Queries and filters only look tags up, so asking about a tag never uses up a bit.
+class TagDB
+{
+public:
+	static inline const int MAX_TAGS = 64;
+
+	// Never given to a tag, stands in for tag names no actor has had in lua masks and filters
+	static inline const int UNKNOWN_TAG_BIT = MAX_TAGS - 1;
+
+	static inline ENGINE_THREAD_LOCAL std::unordered_map<Atom, int> tag_bits;
+
+	// Public method to access the single instance of the class
+	static TagDB& getInstance() {
+		static TagDB instance; // Guaranteed to be created only once
+		return instance;
+	}
+
+	// Bit of the tag, assigned if the tag is new
+	static int GetBit(Atom tag);
+
+	static uint64_t GetMask(Atom tag) { return uint64_t(1) << GetBit(tag); }
+
+	// Mask of the tag, 0 if no actor has had it yet. Never assigns a bit
+	static uint64_t FindMask(Atom tag);
+
+	// Index of the lowest set bit, mask must not be 0
+	static int LowestBit(uint64_t mask) {
+#if defined(_MSC_VER)
+		unsigned long index = 0;
+		_BitScanForward64(&index, mask);
+		return static_cast<int>(index);
+#else
+		return __builtin_ctzll(mask);
+#endif
+	}
+
+	// "tags" of a scene or template actor: a tag name or an array of them
+	static uint64_t MaskFromJson(const rapidjson::Value& value);
+
+	// A tag name, a table of tag names or a mask from Tag.Mask, 0 for anything else.
+	// Unknown tag names add UNKNOWN_TAG_BIT, which no actor has, so they match nothing
+	static uint64_t MaskFromLua(const luabridge::LuaRef& value);
+
+	// Tag.Mask(tags): the mask of a tag name or a table of them, combine masks with | in lua
+	static long long LuaMask(const luabridge::LuaRef& tags);
+
+private:
+	// Private constructor and destructor to prevent multiple instances
+	TagDB() {}
+	~TagDB() = default;
+
+	// Delete copy constructor and assignment operator to prevent copying
+	TagDB(const TagDB&) = delete;
+	TagDB& operator=(const TagDB&) = delete;
+};
+
+#endif
\ No newline at end of file
@@ -21,7 +21,18 @@ Actor* TemplateDB::GetTemplate(std::string templateName) {
 	rapidjson::Document templateDoc;
 	EngineUtils::ReadJsonFile(templateDir.string(), templateDoc);
 
-	templates[templateName] = new Actor(templateDoc, -1);
+	Actor* actor_template = ActorHandle::pool.Create(templateDoc, -1);
+
+	// "pooled": true recycles destroyed instances, keeping up to "pool_size" inactive
+	if (templateDoc.HasMember("pooled") && templateDoc["pooled"].IsBool() && templateDoc["pooled"].GetBool()) {
+		actor_template->pool = new ActorPool();
+		actor_template->pool->capacity = DEFAULT_POOL_SIZE;
+		if (templateDoc.HasMember("pool_size") && templateDoc["pool_size"].IsInt())
+			actor_template->pool->capacity = std::max(0, templateDoc["pool_size"].GetInt());
+		actor_template->pool->inactive.reserve(actor_template->pool->capacity);
+	}
+
+	templates[templateName] = actor_template;
 
 	return templates[templateName];
 }
\ No newline at end of file
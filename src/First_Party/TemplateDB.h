@@ -13,7 +13,10 @@ namespace fs = std::filesystem;
 class TemplateDB
 {
 public:
-	static inline std::unordered_map<std::string, Actor*> templates;
+	static inline ENGINE_THREAD_LOCAL std::unordered_map<std::string, Actor*> templates;
+
+	// Inactive actors kept by a "pooled" template that doesn't set "pool_size"
+	static inline const int DEFAULT_POOL_SIZE = 64;
 
     // Public method to access the single instance of the class
     static TemplateDB& getInstance() {
@@ -26,10 +26,10 @@ struct SDL_ColorEqual {
 class TextDB
 {
 public:
-    static inline std::unordered_map<std::string, std::unordered_map<int, TTF_Font*>> fonts;
+    static inline ENGINE_THREAD_LOCAL std::unordered_map<std::string, std::unordered_map<int, TTF_Font*>> fonts;
 
     // text textures accessible by [text content][font][color]
-    static inline std::unordered_map<std::string, 
+    static inline ENGINE_THREAD_LOCAL std::unordered_map<std::string, 
         std::unordered_map<TTF_Font*, 
         std::unordered_map<SDL_Color, SDL_Texture*, SDL_ColorHash, SDL_ColorEqual>>> text;
 
@@ -0,0 +1,144 @@
+#include "Timer.h"
+#include "EventBus.h"
+#include "NativeComponent.h"
+
+Timer::Timer() {
+
+}
+
+Timer::Timer(Timer* other) {
+	NativeComponentRegistry::CopyFields(this, other);
+}
+
+void Timer::OnStart() {
+	started = true;
+
+	if (autostart)
+		Start();
+}
+
+void Timer::OnEnable() {
+	if (!started) {
+		OnStart();
+		return;
+	}
+
+	if (!paused)
+		return;
+
+	paused = false;
+	slot = static_cast<int>(running_timers.size());
+	running_timers.emplace_back(paused_state);
+}
+
+void Timer::OnDisable() {
+	if (slot == -1)
+		return;
+
+	paused_state = running_timers[slot];
+	Stop();
+	paused = true;
+}
+
+void Timer::OnDestroy() {
+	Stop();
+	callback.reset();
+}
+
+void Timer::Start() {
+	if (interval <= 0.0f) interval = 1.0f / 60.0f;
+	paused = false;
+
+	if (slot != -1) {
+		running_timers[slot] = TimerState(this, interval, loop);
+		return;
+	}
+
+	slot = static_cast<int>(running_timers.size());
+	running_timers.emplace_back(this, interval, loop);
+}
+
+void Timer::Stop() {
+	paused = false;
+	if (slot == -1)
+		return;
+
+	// Swap with the last timer so removal is O(1)
+	running_timers[slot] = running_timers.back();
+	running_timers[slot].owner->slot = slot;
+	running_timers.pop_back();
+
+	slot = -1;
+}
+
+bool Timer::IsRunning() {
+	return slot != -1;
+}
+
+float Timer::GetRemaining() {
+	if (slot == -1)
+		return 0.0f;
+
+	return running_timers[slot].interval - running_timers[slot].elapsed;
+}
+
+void Timer::SetCallback(const luabridge::LuaRef& function) {
+	if (function.isFunction())
+		callback = std::make_shared<luabridge::LuaRef>(function);
+	else
+		callback.reset();
+}
+
+void Timer::Fire() {
+	if (!event.empty())
+		EventBus::Publish(event, NativeComponentRegistry::GetLuaRef(this));
+
+	if (callback) {
+		// Keep the callback alive in case it replaces itself
+		std::shared_ptr<luabridge::LuaRef> function = callback;
+
+		try {
+			(*function)(NativeComponentRegistry::GetLuaRef(this));
+		}
+		catch (const luabridge::LuaException& e) {
+			EngineUtils::ReportError(actor != nullptr ? actor->name : type, e);
+		}
+	}
+}
+
+void Timer::Step() {
+	if (running_timers.empty())
+		return;
+
+	// Fixed step, matches Rigidbody::Step
+	const float delta_time = 1.0f / 60.0f;
+
+	static ENGINE_THREAD_LOCAL std::vector<Timer*> fired_timers;
+
+	for (TimerState& state : running_timers) {
+		if (!state.owner->enabled)
+			continue;
+
+		state.elapsed += delta_time;
+		if (state.elapsed >= state.interval) {
+			state.elapsed -= state.interval;
+			fired_timers.emplace_back(state.owner);
+		}
+	}
+
+	if (fired_timers.empty())
+		return;
+
+	// Fire after the loop since callbacks may start or stop timers
+	for (Timer* timer : fired_timers) {
+		if (timer->slot != -1 && !running_timers[timer->slot].loop)
+			timer->Stop();
+	}
+
+	for (Timer* timer : fired_timers) {
+		if (timer->enabled)
+			timer->Fire();
+	}
+
+	fired_timers.clear();
+}
\ No newline at end of file
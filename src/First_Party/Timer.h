@@ -0,0 +1,84 @@
+#pragma once
+#ifndef TIMER_H
+#define TIMER_H
+
+#include "utility.h"
+#include "actor.h"
+#include "ComponentManager.h"
+
+class Timer;
+
+// Per-frame timer state, kept in one contiguous array for every running timer
+class TimerState {
+public:
+	Timer* owner = nullptr;
+	float elapsed = 0.0f;
+	float interval = 1.0f;
+	bool loop = false;
+
+	TimerState() {}
+
+	TimerState(Timer* _owner, float _interval, bool _loop) : owner(_owner), interval(_interval), loop(_loop) {}
+};
+
+class Timer
+{
+public:
+	static inline ENGINE_THREAD_LOCAL std::vector<TimerState> running_timers;
+
+	std::string type = "Timer";
+	std::string key = "???";
+	Actor* actor = nullptr;
+	bool enabled = true;
+
+	// seconds between firings
+	float interval = 1.0f;
+	bool loop = false;
+	bool autostart = true;
+
+	// Event published on the EventBus every time the timer fires ("" publishes nothing)
+	std::string event = "";
+
+	// Index into running_timers, -1 when stopped
+	int slot = -1;
+
+	bool started = false;
+	// Running state saved by OnDisable, resumed by OnEnable
+	bool paused = false;
+	TimerState paused_state;
+
+	std::shared_ptr<luabridge::LuaRef> callback;
+
+	Timer();
+
+	Timer(Timer* other);
+
+	void OnStart();
+
+	void OnDestroy();
+
+	// Pause while the actor is inactive. OnEnable on a timer that never started (or was reset) starts it.
+	void OnEnable();
+
+	void OnDisable();
+
+	// Start (or restart) the timer from zero
+	void Start();
+
+	void Stop();
+
+	bool IsRunning();
+
+	// Seconds until the timer next fires, 0 if it isn't running
+	float GetRemaining();
+
+	// callback(timer) is called every time the timer fires
+	void SetCallback(const luabridge::LuaRef& function);
+
+	void Fire();
+
+	// Advance every running timer, call once per frame
+	static void Step();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,246 @@
+#include "Transform.h"
+#include "NativeComponent.h"
+
+Transform::Transform() {
+	slot = AllocateSlot();
+	transforms[slot].owner = this;
+}
+
+Transform::Transform(Transform* other) {
+	slot = AllocateSlot();
+
+	transforms[slot].owner = this;
+	NativeComponentRegistry::CopyFields(this, other);
+}
+
+Transform::~Transform() {
+	Detach();
+
+	transforms[slot] = TransformState();
+	free_slots.push_back(slot);
+	slot = -1;
+}
+
+int Transform::AllocateSlot() {
+	if (!free_slots.empty()) {
+		int index = free_slots.back();
+		free_slots.pop_back();
+		return index;
+	}
+
+	transforms.emplace_back();
+	return static_cast<int>(transforms.size()) - 1;
+}
+
+void Transform::OnStart() {
+	if (actor != nullptr)
+		actor->transform = this;
+}
+
+void Transform::OnDestroy() {
+	Detach();
+
+	if (actor != nullptr && actor->transform == this)
+		actor->transform = nullptr;
+}
+
+float Transform::GetX() const { return transforms[slot].x; }
+
+void Transform::SetX(float new_x) {
+	transforms[slot].x = new_x;
+	MarkDirty(slot);
+}
+
+float Transform::GetY() const { return transforms[slot].y; }
+
+void Transform::SetY(float new_y) {
+	transforms[slot].y = new_y;
+	MarkDirty(slot);
+}
+
+float Transform::GetRotation() const { return transforms[slot].rotation; }
+
+void Transform::SetRotation(float new_rotation) {
+	transforms[slot].rotation = new_rotation;
+	MarkDirty(slot);
+}
+
+float Transform::GetScaleX() const { return transforms[slot].scale_x; }
+
+void Transform::SetScaleX(float new_scale_x) {
+	transforms[slot].scale_x = new_scale_x;
+	MarkDirty(slot);
+}
+
+float Transform::GetScaleY() const { return transforms[slot].scale_y; }
+
+void Transform::SetScaleY(float new_scale_y) {
+	transforms[slot].scale_y = new_scale_y;
+	MarkDirty(slot);
+}
+
+b2Vec2 Transform::GetWorldPosition() {
+	UpdateWorld(slot);
+	return b2Vec2(transforms[slot].world_x, transforms[slot].world_y);
+}
+
+float Transform::GetWorldRotation() {
+	UpdateWorld(slot);
+	return transforms[slot].world_rotation;
+}
+
+b2Vec2 Transform::GetWorldScale() {
+	UpdateWorld(slot);
+	return b2Vec2(transforms[slot].world_scale_x, transforms[slot].world_scale_y);
+}
+
+void Transform::SetWorldPosition(const b2Vec2& world_position) {
+	float local_x = world_position.x;
+	float local_y = world_position.y;
+
+	int parent = transforms[slot].parent;
+	if (parent != -1) {
+		UpdateWorld(parent);
+		const TransformState& parent_state = transforms[parent];
+
+		// Undo the parent's translation, rotation and scale, in that order
+		float dx = world_position.x - parent_state.world_x;
+		float dy = world_position.y - parent_state.world_y;
+		float radians = glm::radians(-parent_state.world_rotation);
+		float cos_angle = glm::cos(radians);
+		float sin_angle = glm::sin(radians);
+		local_x = dx * cos_angle - dy * sin_angle;
+		local_y = dx * sin_angle + dy * cos_angle;
+		if (parent_state.world_scale_x != 0.0f) local_x /= parent_state.world_scale_x;
+		if (parent_state.world_scale_y != 0.0f) local_y /= parent_state.world_scale_y;
+	}
+
+	TransformState& state = transforms[slot];
+	if (state.x == local_x && state.y == local_y)
+		return;
+
+	state.x = local_x;
+	state.y = local_y;
+	MarkDirty(slot);
+}
+
+void Transform::SetWorldRotation(float world_rotation) {
+	int parent = transforms[slot].parent;
+	float local_rotation = world_rotation;
+	if (parent != -1)
+		local_rotation -= GetParent()->GetWorldRotation();
+
+	if (transforms[slot].rotation == local_rotation)
+		return;
+
+	transforms[slot].rotation = local_rotation;
+	MarkDirty(slot);
+}
+
+void Transform::SetParent(Transform* parent) {
+	int parent_index = parent != nullptr ? parent->slot : -1;
+	if (transforms[slot].parent == parent_index)
+		return;
+
+	for (int ancestor = parent_index; ancestor != -1; ancestor = transforms[ancestor].parent) {
+		if (ancestor == slot)
+			return;
+	}
+
+	// Unlink from the old parent's child list
+	int old_parent = transforms[slot].parent;
+	if (old_parent != -1) {
+		int* link = &transforms[old_parent].first_child;
+		while (*link != slot)
+			link = &transforms[*link].next_sibling;
+		*link = transforms[slot].next_sibling;
+	}
+
+	TransformState& state = transforms[slot];
+	state.parent = parent_index;
+	state.next_sibling = -1;
+	if (parent_index != -1) {
+		state.next_sibling = transforms[parent_index].first_child;
+		transforms[parent_index].first_child = slot;
+	}
+
+	MarkDirty(slot);
+}
+
+Transform* Transform::GetParent() {
+	int parent = transforms[slot].parent;
+	return parent != -1 ? transforms[parent].owner : nullptr;
+}
+
+luabridge::LuaRef Transform::LuaGetParent() {
+	return NativeComponentRegistry::GetLuaRef(GetParent());
+}
+
+luabridge::LuaRef Transform::GetChildren() {
+	lua_State* lua_state = ComponentManager::GetLuaState();
+	luabridge::LuaRef children = luabridge::newTable(lua_state);
+
+	int index = 1;
+	for (int child = transforms[slot].first_child; child != -1; child = transforms[child].next_sibling)
+		children[index++] = NativeComponentRegistry::GetLuaRef(transforms[child].owner);
+
+	return children;
+}
+
+void Transform::Detach() {
+	if (slot == -1)
+		return;
+
+	SetParent(nullptr);
+
+	int child = transforms[slot].first_child;
+	while (child != -1) {
+		int next = transforms[child].next_sibling;
+		transforms[child].parent = -1;
+		transforms[child].next_sibling = -1;
+		MarkDirty(child);
+		child = next;
+	}
+	transforms[slot].first_child = -1;
+}
+
+void Transform::MarkDirty(int index) {
+	if (transforms[index].dirty)
+		return;
+
+	transforms[index].dirty = true;
+	for (int child = transforms[index].first_child; child != -1; child = transforms[child].next_sibling)
+		MarkDirty(child);
+}
+
+void Transform::UpdateWorld(int index) {
+	TransformState& state = transforms[index];
+	if (!state.dirty)
+		return;
+
+	if (state.parent == -1) {
+		state.world_x = state.x;
+		state.world_y = state.y;
+		state.world_rotation = state.rotation;
+		state.world_scale_x = state.scale_x;
+		state.world_scale_y = state.scale_y;
+	}
+	else {
+		UpdateWorld(state.parent);
+		const TransformState& parent_state = transforms[state.parent];
+
+		float radians = glm::radians(parent_state.world_rotation);
+		float cos_angle = glm::cos(radians);
+		float sin_angle = glm::sin(radians);
+		float scaled_x = state.x * parent_state.world_scale_x;
+		float scaled_y = state.y * parent_state.world_scale_y;
+
+		state.world_x = parent_state.world_x + scaled_x * cos_angle - scaled_y * sin_angle;
+		state.world_y = parent_state.world_y + scaled_x * sin_angle + scaled_y * cos_angle;
+		state.world_rotation = parent_state.world_rotation + state.rotation;
+		state.world_scale_x = parent_state.world_scale_x * state.scale_x;
+		state.world_scale_y = parent_state.world_scale_y * state.scale_y;
+	}
+
+	state.dirty = false;
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#pragma once
+#ifndef TRANSFORM_H
+#define TRANSFORM_H
+
+#include "utility.h"
+#include "actor.h"
+#include "ComponentManager.h"
+
+class Transform;
+
+// Per-transform state, kept in one contiguous array for every transform.
+// Slots are stable while the transform lives so parents and children can refer to each other by index.
+class TransformState {
+public:
+	Transform* owner = nullptr;
+
+	// Relative to the parent, or the world for transforms without one
+	float x = 0.0f;
+	float y = 0.0f;
+	float rotation = 0.0f; // degrees clockwise, like Rigidbody
+	float scale_x = 1.0f;
+	float scale_y = 1.0f;
+
+	// Only valid while dirty is false
+	float world_x = 0.0f;
+	float world_y = 0.0f;
+	float world_rotation = 0.0f;
+	float world_scale_x = 1.0f;
+	float world_scale_y = 1.0f;
+
+	int parent = -1;
+	int first_child = -1;
+	int next_sibling = -1;
+
+	// A dirty transform's children are always dirty too, so marking stops at the first dirty one
+	bool dirty = true;
+};
+
+class Transform
+{
+public:
+	static inline ENGINE_THREAD_LOCAL std::vector<TransformState> transforms;
+	static inline ENGINE_THREAD_LOCAL std::vector<int> free_slots;
+
+	std::string type = "Transform";
+	std::string key = "???";
+	Actor* actor = nullptr;
+	bool enabled = true;
+
+	// Index into transforms
+	int slot = -1;
+
+	Transform();
+
+	Transform(Transform* other);
+
+	~Transform();
+
+	void OnStart();
+
+	void OnDestroy();
+
+	float GetX() const;
+	void SetX(float new_x);
+	float GetY() const;
+	void SetY(float new_y);
+	float GetRotation() const;
+	void SetRotation(float new_rotation);
+	float GetScaleX() const;
+	void SetScaleX(float new_scale_x);
+	float GetScaleY() const;
+	void SetScaleY(float new_scale_y);
+
+	// World values are recomputed on read, only for transforms that moved (or whose parent did)
+	b2Vec2 GetWorldPosition();
+
+	float GetWorldRotation();
+
+	b2Vec2 GetWorldScale();
+
+	// Sets the local values that put this transform at world_position under its parent
+	void SetWorldPosition(const b2Vec2& world_position);
+
+	void SetWorldRotation(float world_rotation);
+
+	// Local values are kept, so the transform moves with its new parent. nil detaches it.
+	// Parenting a transform under itself or one of its children is ignored.
+	void SetParent(Transform* parent);
+
+	Transform* GetParent();
+
+	// GetParent for scripts, the parent's own userdata (or nil)
+	luabridge::LuaRef LuaGetParent();
+
+	// Indexed table of the direct children
+	luabridge::LuaRef GetChildren();
+
+	// Unlinks from the parent, children become roots
+	void Detach();
+
+	static void MarkDirty(int index);
+
+	static void UpdateWorld(int index);
+
+private:
+	static int AllocateSlot();
+};
+
+#endif
\ No newline at end of file
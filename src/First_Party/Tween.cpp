@@ -0,0 +1,226 @@
+#include "Tween.h"
+#include "EventBus.h"
+#include "NativeComponent.h"
+#include "ErrorLog.h"
+
+Tween::Tween() {
+
+}
+
+Tween::Tween(Tween* other) {
+	NativeComponentRegistry::CopyFields(this, other);
+}
+
+void Tween::OnStart() {
+	started = true;
+
+	if (actor != nullptr && !target.empty()) {
+		// Target by key first, then by type
+		luabridge::LuaRef target_component = actor->GetComponentByKey(target);
+		if (target_component.isNil())
+			target_component = actor->GetComponent(target);
+		if (!target_component.isNil())
+			target_ref = std::make_shared<luabridge::LuaRef>(target_component);
+	}
+
+	value = from;
+
+	if (autostart)
+		Play();
+}
+
+void Tween::OnEnable() {
+	if (!started) {
+		OnStart();
+		return;
+	}
+
+	if (!paused)
+		return;
+
+	paused = false;
+	slot = static_cast<int>(playing_tweens.size());
+	playing_tweens.emplace_back(paused_state);
+}
+
+void Tween::OnDisable() {
+	if (slot == -1)
+		return;
+
+	paused_state = playing_tweens[slot];
+	Stop();
+	paused = true;
+}
+
+void Tween::OnDestroy() {
+	Stop();
+	callback.reset();
+	target_ref.reset();
+}
+
+void Tween::Play() {
+	if (duration <= 0.0f) duration = 1.0f / 60.0f;
+	paused = false;
+
+	TweenState state;
+	state.owner = this;
+	state.duration = duration;
+	state.from = from;
+	state.to = to;
+	state.value = from;
+	state.easing = ParseEasing(easing);
+	state.loop = ParseLoop(loop);
+
+	if (slot != -1) {
+		playing_tweens[slot] = state;
+	}
+	else {
+		slot = static_cast<int>(playing_tweens.size());
+		playing_tweens.emplace_back(state);
+	}
+
+	ApplyValue(from);
+}
+
+void Tween::Stop() {
+	paused = false;
+	if (slot == -1)
+		return;
+
+	// Swap with the last tween so removal is O(1)
+	playing_tweens[slot] = playing_tweens.back();
+	playing_tweens[slot].owner->slot = slot;
+	playing_tweens.pop_back();
+
+	slot = -1;
+}
+
+bool Tween::IsPlaying() {
+	return slot != -1;
+}
+
+float Tween::GetValue() {
+	return value;
+}
+
+void Tween::SetCallback(const luabridge::LuaRef& function) {
+	if (function.isFunction())
+		callback = std::make_shared<luabridge::LuaRef>(function);
+	else
+		callback.reset();
+}
+
+void Tween::ApplyValue(float new_value) {
+	value = new_value;
+
+	if (!target_ref || property.empty())
+		return;
+
+	try {
+		(*target_ref)[property] = new_value;
+	}
+	catch (const luabridge::LuaException& e) {
+		// An unknown or read-only property would fail every frame, report it once and stop
+		ErrorLog::Report(actor != nullptr ? actor->name : type, type, e.what());
+		target_ref.reset();
+		Stop();
+	}
+}
+
+void Tween::Complete() {
+	if (!event.empty())
+		EventBus::Publish(event, NativeComponentRegistry::GetLuaRef(this));
+
+	if (callback) {
+		// Keep the callback alive in case it replaces itself
+		std::shared_ptr<luabridge::LuaRef> function = callback;
+
+		try {
+			(*function)(NativeComponentRegistry::GetLuaRef(this));
+		}
+		catch (const luabridge::LuaException& e) {
+			EngineUtils::ReportError(actor != nullptr ? actor->name : type, e);
+		}
+	}
+}
+
+TWEEN_EASING Tween::ParseEasing(const std::string& easing_name) {
+	if (easing_name == "ease_in") return TWEEN_EASING_EASE_IN;
+	if (easing_name == "ease_out") return TWEEN_EASING_EASE_OUT;
+	if (easing_name == "ease_in_out") return TWEEN_EASING_EASE_IN_OUT;
+	if (easing_name == "sine") return TWEEN_EASING_SINE;
+	return TWEEN_EASING_LINEAR;
+}
+
+TWEEN_LOOP Tween::ParseLoop(const std::string& loop_name) {
+	if (loop_name == "repeat") return TWEEN_LOOP_REPEAT;
+	if (loop_name == "ping_pong") return TWEEN_LOOP_PING_PONG;
+	return TWEEN_LOOP_NONE;
+}
+
+float Tween::Ease(TWEEN_EASING easing, float t) {
+	switch (easing) {
+	case TWEEN_EASING_EASE_IN:
+		return t * t;
+	case TWEEN_EASING_EASE_OUT:
+		return t * (2.0f - t);
+	case TWEEN_EASING_EASE_IN_OUT:
+		return (t < 0.5f) ? 2.0f * t * t : -1.0f + (4.0f - 2.0f * t) * t;
+	case TWEEN_EASING_SINE:
+		return 0.5f - 0.5f * glm::cos(t * b2_pi);
+	default:
+		return t;
+	}
+}
+
+void Tween::Step() {
+	if (playing_tweens.empty())
+		return;
+
+	// Fixed step, matches Rigidbody::Step
+	const float delta_time = 1.0f / 60.0f;
+
+	static ENGINE_THREAD_LOCAL std::vector<Tween*> updated_tweens;
+	static ENGINE_THREAD_LOCAL std::vector<Tween*> finished_tweens;
+
+	for (TweenState& state : playing_tweens) {
+		if (!state.owner->enabled)
+			continue;
+
+		state.elapsed += delta_time;
+
+		bool finished_cycle = state.elapsed >= state.duration;
+		float t = finished_cycle ? 1.0f : state.elapsed / state.duration;
+		if (!state.forward) t = 1.0f - t;
+
+		state.value = state.from + (state.to - state.from) * Ease(state.easing, t);
+		updated_tweens.emplace_back(state.owner);
+
+		if (finished_cycle) {
+			if (state.loop == TWEEN_LOOP_PING_PONG)
+				state.forward = !state.forward;
+			state.elapsed -= state.duration;
+			finished_tweens.emplace_back(state.owner);
+		}
+	}
+
+	// Write values and notify after the loop since callbacks may play or stop tweens
+	for (Tween* tween : updated_tweens)
+		tween->ApplyValue(playing_tweens[tween->slot].value);
+	updated_tweens.clear();
+
+	if (finished_tweens.empty())
+		return;
+
+	for (Tween* tween : finished_tweens) {
+		if (tween->slot != -1 && playing_tweens[tween->slot].loop == TWEEN_LOOP_NONE)
+			tween->Stop();
+	}
+
+	for (Tween* tween : finished_tweens) {
+		if (tween->enabled)
+			tween->Complete();
+	}
+
+	finished_tweens.clear();
+}
\ No newline at end of file
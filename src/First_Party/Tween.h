@@ -0,0 +1,121 @@
+#pragma once
+#ifndef TWEEN_H
+#define TWEEN_H
+
+#include "utility.h"
+#include "actor.h"
+#include "ComponentManager.h"
+
+class Tween;
+
+enum TWEEN_EASING {
+	TWEEN_EASING_LINEAR,
+	TWEEN_EASING_EASE_IN,
+	TWEEN_EASING_EASE_OUT,
+	TWEEN_EASING_EASE_IN_OUT,
+	TWEEN_EASING_SINE
+};
+
+enum TWEEN_LOOP {
+	TWEEN_LOOP_NONE,
+	TWEEN_LOOP_REPEAT,
+	TWEEN_LOOP_PING_PONG
+};
+
+// Per-frame tween state, kept in one contiguous array for every playing tween
+class TweenState {
+public:
+	Tween* owner = nullptr;
+	float elapsed = 0.0f;
+	float duration = 1.0f;
+	float from = 0.0f;
+	float to = 1.0f;
+	float value = 0.0f;
+	TWEEN_EASING easing = TWEEN_EASING_LINEAR;
+	TWEEN_LOOP loop = TWEEN_LOOP_NONE;
+	bool forward = true;
+};
+
+class Tween
+{
+public:
+	static inline ENGINE_THREAD_LOCAL std::vector<TweenState> playing_tweens;
+
+	std::string type = "Tween";
+	std::string key = "???";
+	Actor* actor = nullptr;
+	bool enabled = true;
+
+	// Key (or type) of a component on the same actor to write the value into every frame
+	std::string target = "";
+	// Name of the property on the target component
+	std::string property = "";
+
+	float from = 0.0f;
+	float to = 1.0f;
+	// seconds
+	float duration = 1.0f;
+	// linear, ease_in, ease_out, ease_in_out, sine
+	std::string easing = "linear";
+	// none, repeat, ping_pong
+	std::string loop = "none";
+	bool autostart = true;
+
+	// Event published on the EventBus when the tween finishes ("" publishes nothing)
+	std::string event = "";
+
+	// Index into playing_tweens, -1 when stopped
+	int slot = -1;
+
+	bool started = false;
+	// Playing state saved by OnDisable, resumed by OnEnable
+	bool paused = false;
+	TweenState paused_state;
+
+	// Last value written, readable when the tween is stopped
+	float value = 0.0f;
+
+	std::shared_ptr<luabridge::LuaRef> callback;
+	std::shared_ptr<luabridge::LuaRef> target_ref;
+
+	Tween();
+
+	Tween(Tween* other);
+
+	void OnStart();
+
+	void OnDestroy();
+
+	// Pause while the actor is inactive. OnEnable on a tween that never started (or was reset) starts it.
+	void OnEnable();
+
+	void OnDisable();
+
+	// Play (or restart) the tween from the beginning
+	void Play();
+
+	void Stop();
+
+	bool IsPlaying();
+
+	float GetValue();
+
+	// callback(tween) is called when the tween finishes
+	void SetCallback(const luabridge::LuaRef& function);
+
+	// Writes the value into the target's property. A failed write is reported and stops the tween.
+	void ApplyValue(float new_value);
+
+	void Complete();
+
+	static TWEEN_EASING ParseEasing(const std::string& easing_name);
+
+	static TWEEN_LOOP ParseLoop(const std::string& loop_name);
+
+	static float Ease(TWEEN_EASING easing, float t);
+
+	// Advance every playing tween, call once per frame
+	static void Step();
+};
+
+#endif
\ No newline at end of file
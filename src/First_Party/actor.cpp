@@ -1,9 +1,19 @@
 #include "actor.h"
 #include "gameData.h"
+#include "SystemManager.h"
+#include "ComponentSchema.h"
+#include "scene.h"
+#include "Rigidbody.h"
+#include "TagDB.h"
+#include "NativeComponent.h"
 
 void Actor::InitializeActor(const rapidjson::Value& actor) {
 	if (actor.HasMember("name")) {
 		name = actor["name"].GetString();
+		name_id = name;
+	}
+	if (actor.HasMember("tags")) {
+		tag_mask |= TagDB::MaskFromJson(actor["tags"]);
 	}
 	if (actor.HasMember("components")) {
 		//const auto& componentArray = actor["components"].GetArray();
@@ -17,17 +27,19 @@ void Actor::InitializeActor(const rapidjson::Value& actor) {
 			bool templated = false;
 
 			// Don't override a potential templated component
-			if (components.find(key) == components.end()) {
+			newComp = FindComponent(key);
+			if (newComp == nullptr) {
 				std::string type = componentData["type"].GetString();
 
 				newComp = ComponentManager::GetComponentInstance(type);
-				components[key] = newComp;
+				newComp->key = key;
+				InsertComponent(newComp);
 
-				// Insert key self reference into component
-				(*newComp->componentRef)["key"] = key.c_str();
+				// Insert key self reference into component, native ones get it from InjectConvenienceReferences
+				if (newComp->native_type == nullptr)
+					(*newComp->componentRef)["key"] = key.c_str();
 			}
 			else {
-				newComp = components[key];
 				templated = true;
 			}
 
@@ -37,6 +49,24 @@ void Actor::InitializeActor(const rapidjson::Value& actor) {
 				if (componentType == "type")
 					continue;
 
+				// Schema fields are written straight into native storage
+				if (newComp->schema != nullptr) {
+					int field_index = newComp->schema->FindField(componentType);
+					if (field_index != -1) {
+						newComp->schema->SetFieldFromJson(newComp->schema_slot, field_index, fieldIt->value);
+						continue;
+					}
+				}
+
+				// Reflected native fields are written straight into the instance
+				if (newComp->native_type != nullptr) {
+					int field_index = newComp->native_type->FindField(Atom(componentType));
+					if (field_index != -1) {
+						newComp->native_type->fields[field_index].set_from_json(newComp->native_instance, fieldIt->value);
+						continue;
+					}
+				}
+
 				// Handle different types dynamically
 				if (fieldIt->value.IsString()) {
 					(*newComp->componentRef)[componentType] = fieldIt->value.GetString();
@@ -58,138 +88,138 @@ void Actor::InitializeActor(const rapidjson::Value& actor) {
 			}
 
 			InjectConvenienceReferences(newComp);
-			gettableComponents[newComp->type].emplace_back(newComp);
 		}
 	}
+}
+
+void Actor::CopyTemplateComponents(Actor* templatedActor) {
+	components.Reserve(templatedActor->components.size());
 
-	if (!components.empty()) {
-		RefreshAcceleratingStructures();
+	for (Component* templateComp : templatedActor->components) {
+		Component* newComp = ComponentManager::GetTemplatedComponentInstance(templateComp);
+		newComp->key = templateComp->key;
+		InjectConvenienceReferences(newComp);
+
+		// The template's list is already in key order, so appending keeps it sorted
+		components.push_back(newComp);
+		AddCollisionListener(newComp, true);
 	}
 }
 
-void Actor::QueueStartFunctions(std::queue<Component*>& functionQueue) {
-	for (auto it = components.begin(); it != components.end(); ++it) {
-		if (it->second->hasStart) {
-			//luabridge::LuaRef OnStartFunction = (*it->second->componentRef)["OnStart"];
-			functionQueue.push(it->second);
-		}
+void Actor::CopySnapshotComponents(const Actor& snapshot) {
+	components.Reserve(snapshot.components.size());
+
+	for (Component* snapshotComp : snapshot.components) {
+		Component* templateComp = actor_template != nullptr ? actor_template->FindComponent(snapshotComp->key) : nullptr;
+		Component* newComp = ComponentManager::GetSnapshotComponentInstance(snapshotComp, templateComp);
+		newComp->key = snapshotComp->key;
+		InjectConvenienceReferences(newComp);
+
+		components.push_back(newComp);
+		AddCollisionListener(newComp, true);
 	}
 }
 
-void Actor::Start() {
-	started = true;
+template <size_t N>
+static Component** LowerBoundByKey(SmallVector<Component*, N>& list, const std::string& key) {
+	return std::lower_bound(list.begin(), list.end(), key,
+		[](Component* component, const std::string& other_key) { return component->key < other_key; });
+}
 
-	for (auto it = components.begin(); it != components.end(); ++it) {
-		if (!it->second->hasStart)
-			continue;
+template <size_t N>
+static void InsertSortedByKey(SmallVector<Component*, N>& list, Component* component) {
+	Component** it = std::upper_bound(list.begin(), list.end(), component->key,
+		[](const std::string& key, Component* other) { return key < other->key; });
 
-		if (it->second->IsEnabled()) {
-			luabridge::LuaRef OnStartFunction = (*it->second->componentRef)["OnStart"];
-			//luabridge::LuaRef enabled = (*it->second->componentRef)["enabled"];
+	list.insert(it, component);
+}
 
-			//std::cout << (*it->second->componentRef)["actor"];
+template <size_t N>
+static void EraseSortedByKey(SmallVector<Component*, N>& list, Component* component) {
+	Component** it = LowerBoundByKey(list, component->key);
 
-			try {
-				// Call lua OnUpdate() if enabled property is true
-				//if (enabled.cast<bool>() == true)
-				OnStartFunction(*it->second->componentRef);
-			}
-			catch (const luabridge::LuaException& e) {
-				EngineUtils::ReportError(name, e);
-			}
-		}
-	}
-}
+	// Keys are unique, but fall back to a scan rather than erase the wrong component
+	if (it == list.end() || *it != component)
+		it = std::find(list.begin(), list.end(), component);
 
-void Actor::ProcessAddedComponents() {
-	if (added_components.empty())
-		return;
+	if (it != list.end())
+		list.erase(it);
+}
 
-	while (!added_components.empty()) {
-		Component* newComp = added_components.front();
+Component* Actor::FindComponent(const std::string& key) {
+	Component** it = LowerBoundByKey(components, key);
 
-		if (newComp->IsEnabled() && newComp->hasStart) {
-			luabridge::LuaRef OnStartFunction = (*newComp->componentRef)["OnStart"];
-			//luabridge::LuaRef enabled = (*it->second->componentRef)["enabled"];
+	if (it != components.end() && (*it)->key == key)
+		return *it;
+	return nullptr;
+}
 
-			try {
-				// Call lua OnUpdate() if enabled property is true
-				//if (enabled.cast<bool>() == true)
-				OnStartFunction(*newComp->componentRef);
-			}
-			catch (const luabridge::LuaException& e) {
-				EngineUtils::ReportError(name, e);
-			}
-		}
+void Actor::InsertComponent(Component* component) {
+	InsertSortedByKey(components, component);
+	AddCollisionListener(component, false);
+}
 
-		components[(*newComp->componentRef)["key"].tostring()] = newComp;
-		gettableComponents[newComp->type].emplace_back(newComp);
+void Actor::EraseComponent(Component* component) {
+	EraseSortedByKey(components, component);
+	RemoveCollisionListener(component);
+}
 
-		added_components.pop();
+void Actor::QueueStartFunctions(std::queue<Component*>& functionQueue) {
+	for (Component* component : components) {
+		if (component->hasStart) {
+			//luabridge::LuaRef OnStartFunction = (*component->componentRef)["OnStart"];
+			functionQueue.push(component);
+		}
 	}
-
-	RefreshAcceleratingStructures();
 }
 
-void Actor::Update() {
-	for (auto it = components_requiring_onupdate.begin(); it != components_requiring_onupdate.end(); ++it) {
-		if (it->second->IsEnabled()) {
-			luabridge::LuaRef OnUpdateFunction = (*it->second->componentRef)["OnUpdate"];
-			//luabridge::LuaRef enabled = (*it->second->componentRef)["enabled"];
+void Actor::Start() {
+	started = true;
 
-			try {
-				// Call lua OnUpdate() if enabled property is true
-				//if (enabled.cast<bool>() == true)
-					OnUpdateFunction(*it->second->componentRef);
-			}
-			catch (const luabridge::LuaException& e) {
-				EngineUtils::ReportError(name, e);
-			}
-		}
+	for (Component* component : components) {
+		SystemManager::AddComponent(component);
+
+		if (!component->hasStart)
+			continue;
+
+		if (component->IsEnabled())
+			ComponentManager::CallLifecycle(component, COMPONENT_LIFECYCLE_START, name);
 	}
 }
 
-void Actor::LateUpdate() {
-	for (auto it = components_requiring_onlateupdate.begin(); it != components_requiring_onlateupdate.end(); ++it) {
-		if (it->second->IsEnabled()) {
-			luabridge::LuaRef OnLateUpdateFunction = (*it->second->componentRef)["OnLateUpdate"];
-			//luabridge::LuaRef enabled = (*it->second->componentRef)["enabled"];
+void Actor::ProcessAddedComponents() {
+	if (added_components.empty())
+		return;
 
-			try {
-				// Call lua OnUpdate() if enabled property is true
-				//if (enabled.cast<bool>() == true)
-				OnLateUpdateFunction(*it->second->componentRef);
-			}
-			catch (const luabridge::LuaException& e) {
-				EngineUtils::ReportError(name, e);
-			}
+	// Index loop, OnStart may add more components which are processed this pass too
+	for (size_t i = 0; i < added_components.size(); i++) {
+		Component* newComp = added_components[i];
+
+		// An actor that hasn't started yet starts its new components along with the rest
+		if (started && newComp->IsEnabled() && newComp->hasStart)
+			ComponentManager::CallLifecycle(newComp, COMPONENT_LIFECYCLE_START, name);
+
+		InsertComponent(newComp);
+		if (scene != nullptr && in_dispatch) {
+			SystemManager::AddComponent(newComp);
+			scene->AddToDispatch(this, newComp);
 		}
 	}
+
+	added_components.clear();
 }
 
 void Actor::InjectConvenienceReferences(Component* component_ref) {
+	// Native instances are set directly, only lua components go through their table
+	if (component_ref->native_type != nullptr) {
+		component_ref->native_type->bind(component_ref->native_instance, this, component_ref->key);
+		return;
+	}
+
 	(*component_ref->componentRef)["actor"] = this;
 	(*component_ref->componentRef)["enabled"] = true;
 }
 
-void Actor::RefreshAcceleratingStructures() {
-	components_requiring_onupdate.clear();
-	components_requiring_onlateupdate.clear();
-
-	for (auto it = components.begin(); it != components.end(); ++it) {
-		// Check each component for onStart, onUpdate, and onLateUpdate functions and do with them what I will
-		//std::cout << it->second->type << ", ";
-		Component* comp = it->second;
-		std::string key = it->first;
-
-		if (comp->hasUpdate)
-			components_requiring_onupdate[key] = comp;
-		if (comp->hasLateUpdate)
-			components_requiring_onlateupdate[key] = comp;
-	}
-	//std::cout << "\n";
-}
-
 std::string Actor::GetName() {
 	return name;
 }
@@ -201,9 +231,9 @@ int Actor::GetID() {
 // Obtains reference to a component via key.
 // (return nil if the key doesnt exist)
 luabridge::LuaRef Actor::GetComponentByKey(const std::string& key) {
-	auto ref = components.find(key);
-	if (ref != components.end() && ref->second->IsEnabled())
-		return *ref->second->componentRef;
+	Component* component = FindComponent(key);
+	if (component != nullptr && component->IsEnabled())
+		return *component->componentRef;
 	else
 		return luabridge::LuaRef(ComponentManager::GetLuaState()); // returns nil to lua
 }
@@ -211,15 +241,11 @@ luabridge::LuaRef Actor::GetComponentByKey(const std::string& key) {
 // Obtains reference to component via type.
 // If multiple components exist of a type, return the first(sorted by component key).
 // (return nil if no components of the type exist)
-luabridge::LuaRef Actor::GetComponent(const std::string& type_name) {
-	auto components_with_type = gettableComponents.find(type_name);
-
-	if (components_with_type == gettableComponents.end())
-		return luabridge::LuaRef(ComponentManager::GetLuaState()); // returns nil to lua if none found
-
-	for (Component* component : components_with_type->second) {
-		if (component->IsEnabled()) 
-				return *component->componentRef;
+luabridge::LuaRef Actor::GetComponent(Atom type_name) {
+	// Linear scan of the key sorted list, the first match is the lowest key
+	for (Component* component : components) {
+		if (component->type_id == type_name && component->IsEnabled())
+			return *component->componentRef;
 	}
 
 	/*
@@ -238,18 +264,13 @@ luabridge::LuaRef Actor::GetComponent(const std::string& type_name) {
 // The components should be returned in sorted order(by their key)
 // Hint: remember that Lua tables index starting at 1, not 0
 // (return an empty table if no components of the desired type exist)
-luabridge::LuaRef Actor::GetComponents(const std::string& type_name) {
-	auto components_with_type = gettableComponents.find(type_name);
-
-	if (components_with_type == gettableComponents.end())
-		return luabridge::LuaRef(ComponentManager::GetLuaState()); // returns nil to lua if none found
-
+luabridge::LuaRef Actor::GetComponents(Atom type_name) {
 	luabridge::LuaRef ref = luabridge::newTable(ComponentManager::GetLuaState());
 	bool foundSomething = false;
 	int index = 1; // Lua tables are 1-based
 
-	for (Component* component : components_with_type->second) {
-		if (component->IsEnabled()) {
+	for (Component* component : components) {
+		if (component->type_id == type_name && component->IsEnabled()) {
 			ref[index] = *component->componentRef; // Insert using numeric index
 			foundSomething = true;
 			index++;
@@ -277,173 +298,376 @@ luabridge::LuaRef Actor::AddComponent(const std::string& type_name) {
 	std::string key = GameData::GetRuntimeComponentKey();
 
 	// Insert key self reference into component
-	(*newComp->componentRef)["key"] = key.c_str();
+	newComp->key = key;
+	if (newComp->native_type == nullptr)
+		(*newComp->componentRef)["key"] = key.c_str();
 	InjectConvenienceReferences(newComp);
 
-	added_components.push(newComp);
+	// Started actors are queued with their scene, actors that haven't started are checked when they do
+	if (scene != nullptr && added_components.empty())
+		scene->actors_with_added_components.emplace_back(this);
+
+	added_components.push_back(newComp);
 
 	return *newComp->componentRef;
 }
 
 void Actor::RemoveComponent(const luabridge::LuaRef& component_ref) {
-	// TODO: MAKE SURE THAT THIS REGISTERS IN THE RIGIDBODY vv
-	component_ref["enabled"] = false; 
+	Component* comp = ComponentManager::FindComponentByRef(component_ref);
+	if (comp == nullptr)
+		return;
 
-	Component* comp = nullptr;
+	comp->SetEnabled(false);
 
-	for (auto it = components.begin(); it != components.end(); ++it) {
-		if (*it->second->componentRef == component_ref) {
-			comp = it->second;
-			break;
-		}
-	}
+	// Only components this actor already holds, ones added this frame aren't in components yet
+	if (FindComponent(comp->key) == comp) {
+		if (scene != nullptr && removed_components.empty())
+			scene->actors_with_removed_components.emplace_back(this);
 
-	if (comp != nullptr)
-		removed_components.push(comp);
+		removed_components.push_back(comp);
+	}
 }
 
 void Actor::ProcessRemovedComponents() {
 	if (removed_components.empty())
 		return;
 
-	while (!removed_components.empty()) {
-		Component* newComp = removed_components.front();
+	for (size_t i = 0; i < removed_components.size(); i++) {
+		Component* newComp = removed_components[i];
 
-		auto components_with_type = gettableComponents.find(newComp->type);
+		EraseComponent(newComp);
+		SystemManager::RemoveComponent(newComp);
+		if (scene != nullptr)
+			scene->RemoveFromDispatch(this, newComp);
 
-		if (components_with_type != gettableComponents.end()) {
-			auto it = std::find(components_with_type->second.begin(), components_with_type->second.end(), newComp);
-			if (it != components_with_type->second.end()) {
-				components_with_type->second.erase(it);
-			}
-		}
+		if (newComp->hasOnDestroy)
+			ComponentManager::CallLifecycle(newComp, COMPONENT_LIFECYCLE_DESTROY, name);
+		ComponentManager::component_pool.Release(newComp);
+	}
 
-		components.erase((*newComp->componentRef)["key"].tostring());
+	removed_components.clear();
+}
+
+void Actor::Destroy() {
+	destroyed = true;
 
-		// TODO DRY VIOLATION: Make a destroy component function 
-		if (newComp->hasOnDestroy) {
-			luabridge::LuaRef OnDestroyFunction = (*newComp->componentRef)["OnDestroy"];
+	for (Component* component : components) {
+		component->SetEnabled(false);
+	}
+}
 
-			try {
-				// Call lua OnDestroy() if it exists
-				OnDestroyFunction(*newComp->componentRef);
-			}
-			catch (const luabridge::LuaException& e) {
-				EngineUtils::ReportError(name, e);
-			}
+void Actor::OnDestroy() {
+	for (Component* component : components) {
+		if (component->hasOnDestroy)
+			ComponentManager::CallLifecycle(component, COMPONENT_LIFECYCLE_DESTROY, name);
+		SystemManager::RemoveComponent(component);
+		ComponentManager::component_pool.Release(component);
+	}
+
+	components.clear();
+
+	for (int callback = 0; callback < COLLISION_CALLBACK_COUNT; callback++)
+		collision_listeners[callback].clear();
+	collision_callback_mask = 0;
+}
+
+bool Actor::CanReturnToPool() {
+	if (actor_template == nullptr || actor_template->pool == nullptr || dontDestroyOnLoad)
+		return false;
+	if (actor_template->pool->inactive.size() >= actor_template->pool->capacity)
+		return false;
+	if (!added_components.empty() || !removed_components.empty())
+		return false;
+
+	// Both lists are sorted by key, so a matching actor lines up index for index
+	if (components.size() != actor_template->components.size())
+		return false;
+	for (size_t i = 0; i < components.size(); i++) {
+		Component* component = components[i];
+		Component* template_component = actor_template->components[i];
+		if (component->key != template_component->key || component->type_id != template_component->type_id)
+			return false;
+	}
+
+	return true;
+}
+
+void Actor::Deactivate() {
+	for (size_t i = 0; i < components.size(); i++) {
+		Component* component = components[i];
+
+		// An inactive actor's components already had OnDisable
+		if (component->hasOnDisable) {
+			if (in_dispatch)
+				ComponentManager::CallLifecycle(component, COMPONENT_LIFECYCLE_DISABLE, name);
 		}
-		delete newComp;
+		else if (component->hasOnDestroy)
+			ComponentManager::CallLifecycle(component, COMPONENT_LIFECYCLE_DESTROY, name);
+		SystemManager::RemoveComponent(component);
+	}
 
-		removed_components.pop();
+	// Handles to the old actor go stale before the components get their new one, so a reused
+	// actor's scripts don't hold a handle that resolves to nothing, and its old event subscriptions
+	// are told apart from the ones it makes again in OnStart
+	ActorHandle::pool.Invalidate(this);
+
+	for (size_t i = 0; i < components.size(); i++) {
+		Component* component = components[i];
+		component->ResetTo(actor_template->components[i]);
+		InjectConvenienceReferences(component);
 	}
 
-	RefreshAcceleratingStructures();
+	SetTagMask(actor_template->tag_mask);
 }
 
-void Actor::Destroy() {
-	destroyed = true;
+void Actor::SetActive(bool new_active) {
+	if (active == new_active || destroyed)
+		return;
 
-	for (auto it = components.begin(); it != components.end(); ++it) {
-		(*it->second->componentRef)["enabled"] = false;
+	active = new_active;
+
+	// Actors that haven't joined a scene yet are checked when they do
+	if (scene == nullptr || scene_index == -1)
+		return;
+
+	if (!active) {
+		if (in_dispatch)
+			LeaveDispatch();
+	}
+	else {
+		scene->actors_to_activate.emplace_back(this);
 	}
 }
 
-void Actor::OnDestroy() {
-	for (auto it = components.begin(); it != components.end(); ++it) {
-		if (it->second->hasOnDestroy) {
-			luabridge::LuaRef OnDestroyFunction = (*it->second->componentRef)["OnDestroy"];
+void Actor::EnterDispatch() {
+	in_dispatch = true;
 
-			try {
-				// Call lua OnDestroy() if it exists
-				OnDestroyFunction(*it->second->componentRef);
-			}
-			catch (const luabridge::LuaException& e) {
-				EngineUtils::ReportError(name, e);
-			}
-		}
-		delete it->second;
+	// An actor that joined the scene inactive starts now
+	if (!started) {
+		for (Component* component : components)
+			scene->AddToDispatch(this, component);
+		Start();
+		return;
 	}
 
-	components.clear();
+	for (Component* component : components) {
+		scene->AddToDispatch(this, component);
+		SystemManager::AddComponent(component);
+
+		if (component->hasOnEnable && component->IsEnabled())
+			ComponentManager::CallLifecycle(component, COMPONENT_LIFECYCLE_ENABLE, name);
+	}
 }
 
-// TODO: Add accelerating structures for this
-void Actor::OnCollisionEnter(Collision* collision) {
-	if (destroyed) return;
+void Actor::LeaveDispatch() {
+	in_dispatch = false;
 
-	for (auto it = components.begin(); it != components.end(); ++it) {
-		if (it->second->hasOnCollisionEnter) {
-			if (it->second->IsEnabled()) {
-				luabridge::LuaRef OnColEnterFunc = (*it->second->componentRef)["OnCollisionEnter"];
+	for (Component* component : components) {
+		scene->RemoveFromDispatch(this, component);
+		SystemManager::RemoveComponent(component);
 
-				try {
-					// Call lua OnCollisionEnter() if enabled property is true
-					OnColEnterFunc(*it->second->componentRef, collision);
-				}
-				catch (const luabridge::LuaException& e) {
-					EngineUtils::ReportError(name, e);
-				}
-			}
-		}
+		if (component->hasOnDisable && component->IsEnabled())
+			ComponentManager::CallLifecycle(component, COMPONENT_LIFECYCLE_DISABLE, name);
 	}
 }
 
-void Actor::OnCollisionExit(Collision* collision) {
-	if (destroyed) return;
+void Actor::SetTagMask(uint64_t new_mask) {
+	if (new_mask == tag_mask)
+		return;
 
-	for (auto it = components.begin(); it != components.end(); ++it) {
-		if (it->second->hasOnCollisionExit) {
-			if (it->second->IsEnabled()) {
-				luabridge::LuaRef OnColExitFunc = (*it->second->componentRef)["OnCollisionExit"];
+	uint64_t old_mask = tag_mask;
+	tag_mask = new_mask;
 
-				try {
-					// Call lua OnCollisionExit() if enabled property is true
-					OnColExitFunc(*it->second->componentRef, collision);
-				}
-				catch (const luabridge::LuaException& e) {
-					EngineUtils::ReportError(name, e);
-				}
-			}
-		}
+	if (scene != nullptr && scene_index != -1)
+		scene->UpdateTagLists(this, old_mask, new_mask);
+}
+
+void Actor::Reuse(int new_id) {
+	id = new_id;
+	destroyed = false;
+	active = true;
+}
+
+void Actor::Activate() {
+	for (Component* component : components) {
+		SystemManager::AddComponent(component);
+
+		if (!component->IsEnabled())
+			continue;
+
+		if (component->hasOnEnable)
+			ComponentManager::CallLifecycle(component, COMPONENT_LIFECYCLE_ENABLE, name);
+		else if (component->hasStart)
+			ComponentManager::CallLifecycle(component, COMPONENT_LIFECYCLE_START, name);
 	}
 }
 
+void Actor::OnCollisionEnter(Collision* collision) {
+	DispatchCollision(COLLISION_CALLBACK_COLLISION_ENTER, "OnCollisionEnter", collision);
+}
+
+void Actor::OnCollisionExit(Collision* collision) {
+	DispatchCollision(COLLISION_CALLBACK_COLLISION_EXIT, "OnCollisionExit", collision);
+}
+
 void Actor::OnTriggerEnter(Collision* collision) {
+	DispatchCollision(COLLISION_CALLBACK_TRIGGER_ENTER, "OnTriggerEnter", collision);
+}
+
+void Actor::OnTriggerExit(Collision* collision) {
+	DispatchCollision(COLLISION_CALLBACK_TRIGGER_EXIT, "OnTriggerExit", collision);
+}
+
+void Actor::DispatchCollision(COLLISION_CALLBACK callback, const char* function_name, Collision* collision) {
 	if (destroyed) return;
 
-	for (auto it = components.begin(); it != components.end(); ++it) {
-		if (it->second->hasOnTriggerEnter) {
-			if (it->second->IsEnabled()) {
-				luabridge::LuaRef OnTrigEnterFunc = (*it->second->componentRef)["OnTriggerEnter"];
+	for (Component* component : collision_listeners[callback]) {
+		if (component->IsEnabled()) {
+			luabridge::LuaRef CollisionFunc = (*component->componentRef)[function_name];
 
-				try {
-					// Call lua OnTriggerEnter() if enabled property is true
-					OnTrigEnterFunc(*it->second->componentRef, collision);
-				}
-				catch (const luabridge::LuaException& e) {
-					EngineUtils::ReportError(name, e);
-				}
+			try {
+				// Call the lua collision/trigger function if enabled property is true.
+				// Passed by value, the Collision lives on the contact listener's stack.
+				CollisionFunc(*component->componentRef, *collision);
+			}
+			catch (const luabridge::LuaException& e) {
+				EngineUtils::ReportError(name, component, e);
 			}
 		}
 	}
 }
 
-void Actor::OnTriggerExit(Collision* collision) {
-	if (destroyed) return;
+static bool ListensFor(Component* component, COLLISION_CALLBACK callback) {
+	switch (callback) {
+	case COLLISION_CALLBACK_COLLISION_ENTER: return component->hasOnCollisionEnter;
+	case COLLISION_CALLBACK_COLLISION_EXIT: return component->hasOnCollisionExit;
+	case COLLISION_CALLBACK_TRIGGER_ENTER: return component->hasOnTriggerEnter;
+	case COLLISION_CALLBACK_TRIGGER_EXIT: return component->hasOnTriggerExit;
+	default: return false;
+	}
+}
 
-	for (auto it = components.begin(); it != components.end(); ++it) {
-		if (it->second->hasOnTriggerExit) {
-			if (it->second->IsEnabled()) {
-				luabridge::LuaRef OnTrigExitFunc = (*it->second->componentRef)["OnTriggerExit"];
+void Actor::AddCollisionListener(Component* component, bool in_key_order) {
+	for (int callback = 0; callback < COLLISION_CALLBACK_COUNT; callback++) {
+		if (!ListensFor(component, static_cast<COLLISION_CALLBACK>(callback)))
+			continue;
 
-				try {
-					// Call lua OnTriggerExit() if enabled property is true
-					OnTrigExitFunc(*it->second->componentRef, collision);
-				}
-				catch (const luabridge::LuaException& e) {
-					EngineUtils::ReportError(name, e);
-				}
-			}
-		}
+		if (in_key_order)
+			collision_listeners[callback].push_back(component);
+		else
+			InsertSortedByKey(collision_listeners[callback], component);
+
+		collision_callback_mask |= (1 << callback);
 	}
 }
+
+void Actor::RemoveCollisionListener(Component* component) {
+	for (int callback = 0; callback < COLLISION_CALLBACK_COUNT; callback++) {
+		if (!ListensFor(component, static_cast<COLLISION_CALLBACK>(callback)))
+			continue;
+
+		EraseSortedByKey(collision_listeners[callback], component);
+
+		if (collision_listeners[callback].empty())
+			collision_callback_mask &= ~(1 << callback);
+	}
+}
+
+ActorHandle::ActorHandle(Actor* actor) :
+	index(ActorHandle::pool.IndexOf(actor)), generation(ActorHandle::pool.GenerationOf(actor)) {}
+
+Actor* ActorHandle::Get() const {
+	return pool.Get(index, generation);
+}
+
+bool ActorHandle::IsValid() const {
+	Actor* actor = Get();
+	return actor != nullptr && !actor->destroyed;
+}
+
+bool ActorHandle::operator==(const ActorHandle& other) const {
+	return index == other.index && generation == other.generation;
+}
+
+luabridge::LuaRef ActorHandle::GetName() const {
+	Actor* actor = Get();
+	if (actor == nullptr)
+		return luabridge::LuaRef(ComponentManager::GetLuaState());
+	return luabridge::LuaRef(ComponentManager::GetLuaState(), actor->name);
+}
+
+luabridge::LuaRef ActorHandle::GetID() const {
+	Actor* actor = Get();
+	if (actor == nullptr)
+		return luabridge::LuaRef(ComponentManager::GetLuaState());
+	return luabridge::LuaRef(ComponentManager::GetLuaState(), actor->id);
+}
+
+luabridge::LuaRef ActorHandle::GetComponentByKey(const std::string& key) const {
+	Actor* actor = Get();
+	if (actor == nullptr)
+		return luabridge::LuaRef(ComponentManager::GetLuaState());
+	return actor->GetComponentByKey(key);
+}
+
+luabridge::LuaRef ActorHandle::GetComponent(Atom type_name) const {
+	Actor* actor = Get();
+	if (actor == nullptr)
+		return luabridge::LuaRef(ComponentManager::GetLuaState());
+	return actor->GetComponent(type_name);
+}
+
+luabridge::LuaRef ActorHandle::GetComponents(Atom type_name) const {
+	Actor* actor = Get();
+	if (actor == nullptr)
+		return luabridge::LuaRef(ComponentManager::GetLuaState());
+	return actor->GetComponents(type_name);
+}
+
+luabridge::LuaRef ActorHandle::AddComponent(const std::string& type_name) const {
+	Actor* actor = Get();
+	if (actor == nullptr)
+		return luabridge::LuaRef(ComponentManager::GetLuaState());
+	return actor->AddComponent(type_name);
+}
+
+void ActorHandle::RemoveComponent(const luabridge::LuaRef& component_ref) const {
+	Actor* actor = Get();
+	if (actor != nullptr)
+		actor->RemoveComponent(component_ref);
+}
+
+void ActorHandle::SetActive(bool active) const {
+	Actor* actor = Get();
+	if (actor != nullptr)
+		actor->SetActive(active);
+}
+
+bool ActorHandle::IsActive() const {
+	Actor* actor = Get();
+	return actor != nullptr && actor->active;
+}
+
+void ActorHandle::AddTag(Atom tag) const {
+	Actor* actor = Get();
+	if (actor != nullptr)
+		actor->SetTagMask(actor->tag_mask | TagDB::GetMask(tag));
+}
+
+void ActorHandle::RemoveTag(Atom tag) const {
+	Actor* actor = Get();
+	if (actor != nullptr)
+		actor->SetTagMask(actor->tag_mask & ~TagDB::FindMask(tag));
+}
+
+bool ActorHandle::HasTag(Atom tag) const {
+	Actor* actor = Get();
+	return actor != nullptr && (actor->tag_mask & TagDB::FindMask(tag)) != 0;
+}
+
+luabridge::LuaRef ActorHandle::GetTagMask() const {
+	Actor* actor = Get();
+	if (actor == nullptr)
+		return luabridge::LuaRef(ComponentManager::GetLuaState());
+	return luabridge::LuaRef(ComponentManager::GetLuaState(), static_cast<long long>(actor->tag_mask));
+}
\ No newline at end of file
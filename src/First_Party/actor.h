@@ -6,26 +6,77 @@
 #include "ImageDB.h"
 #include "AudioDB.h"
 #include "ComponentManager.h"
+#include "SmallVector.h"
+#include "SlabPool.h"
 #include <optional>
 #include <map>
 #include <cmath>
 
 class Collision;
+class Scene;
+class Actor;
+class Transform;
+
+// Inactive actors of a template that declares "pooled", handed back out by Instantiate
+// instead of building new ones. Only templates own one.
+class ActorPool {
+public:
+	size_t capacity = 0;
+	std::vector<Actor*> inactive;
+};
+
+enum COLLISION_CALLBACK {
+	COLLISION_CALLBACK_COLLISION_ENTER,
+	COLLISION_CALLBACK_COLLISION_EXIT,
+	COLLISION_CALLBACK_TRIGGER_ENTER,
+	COLLISION_CALLBACK_TRIGGER_EXIT,
+	COLLISION_CALLBACK_COUNT
+};
 
 class Actor
 {
 public:
 	std::string name;
+	Atom name_id;
 	int id;
 	bool destroyed;
 	bool dontDestroyOnLoad;
 	bool started;
-	std::map<std::string, Component*> components;
-	std::map<std::string, Component*> components_requiring_onupdate;
-	std::map<std::string, Component*> components_requiring_onlateupdate;
-	std::unordered_map<std::string, std::vector<Component*>> gettableComponents;
-	std::queue<Component*> added_components;
-	std::queue<Component*> removed_components;
+	// Scene the actor has started in and its position in that scene's actors array,
+	// kept current by the scene. nullptr/-1 until the actor starts.
+	Scene* scene = nullptr;
+	int scene_index = -1;
+	// Sorted by key, which is also lifecycle execution order. Most actors have
+	// a handful of components so this stays in the actor's own memory.
+	// OnUpdate/OnLateUpdate are dispatched from the scene, see Scene::update_dispatch.
+	SmallVector<Component*, 8> components;
+
+	// Components with each collision/trigger function, in key order, and a bit per
+	// COLLISION_CALLBACK that is set while its list is non-empty so contacts between
+	// actors nobody listens to can be skipped before a Collision is built
+	SmallVector<Component*, 2> collision_listeners[COLLISION_CALLBACK_COUNT];
+	uint8_t collision_callback_mask = 0;
+	std::vector<Component*> added_components;
+	std::vector<Component*> removed_components;
+
+	// Template this actor was copied from, nullptr for actors declared without one
+	Actor* actor_template = nullptr;
+	// Set on templates with "pooled": true
+	ActorPool* pool = nullptr;
+
+	// False while switched off with SetActive. in_dispatch is whether the scene has
+	// actually put its components in the dispatch lists and systems.
+	bool active = true;
+	bool in_dispatch = false;
+
+	// A bit per tag, see TagDB. Scene and template tags are combined.
+	uint64_t tag_mask = 0;
+
+	// Last SpatialHash build that placed this actor, so one with several Rigidbodies is placed once
+	int spatial_stamp = -1;
+
+	// Set by the actor's Transform component once it starts, if it has one
+	Transform* transform = nullptr;
 
 	Actor(const rapidjson::Value& actor, int id) : 
 		name(""), id(id), destroyed(false), dontDestroyOnLoad(false), started(false) {
@@ -37,51 +88,55 @@ public:
 
 	// Initialize actor from template, override with anything else passed in
 	Actor(Actor* templatedActor, const rapidjson::Value& actor, int id) :
-		name(templatedActor->name), id(id), destroyed(false), dontDestroyOnLoad(false)
+		name(templatedActor->name), name_id(templatedActor->name_id), id(id), destroyed(false), dontDestroyOnLoad(false), started(false),
+		actor_template(templatedActor), tag_mask(templatedActor->tag_mask)
 	{
-		for (auto it = templatedActor->components.begin(); it != templatedActor->components.end(); ++it) {
-			Component* newComp = ComponentManager::GetTemplatedComponentInstance(it->second);
-			components[it->first] = newComp;
-			InjectConvenienceReferences(newComp);
-			gettableComponents[newComp->type].emplace_back(newComp);
-		}
+		CopyTemplateComponents(templatedActor);
 
 		InitializeActor(actor);
 	}
 
 	// Initialize actor from template
 	Actor(Actor* templatedActor, int id) :
-		name(templatedActor->name), id(id), destroyed(false), dontDestroyOnLoad(false), started(false)
+		name(templatedActor->name), name_id(templatedActor->name_id), id(id), destroyed(false), dontDestroyOnLoad(false), started(false),
+		actor_template(templatedActor), tag_mask(templatedActor->tag_mask)
 	{
-		for (auto it = templatedActor->components.begin(); it != templatedActor->components.end(); ++it) {
-			Component* newComp = ComponentManager::GetTemplatedComponentInstance(it->second);
-			components[it->first] = newComp;
-			InjectConvenienceReferences(newComp);
-			gettableComponents[newComp->type].emplace_back(newComp);
-		}
+		CopyTemplateComponents(templatedActor);
+	}
 
-		if (!components.empty()) {
-			RefreshAcceleratingStructures();
-		}
+	// Copy of an actor in a scene snapshot, see SceneDB
+	Actor(const Actor& snapshot, int id) :
+		name(snapshot.name), name_id(snapshot.name_id), id(id), destroyed(false), dontDestroyOnLoad(false), started(false),
+		actor_template(snapshot.actor_template), tag_mask(snapshot.tag_mask)
+	{
+		CopySnapshotComponents(snapshot);
 	}
 
 	void InitializeActor(const rapidjson::Value& actor);
 
+	// Instantiate a copy of every template component, already in key order
+	void CopyTemplateComponents(Actor* templatedActor);
+
+	// Copy of every snapshot component with its values, inheriting from the template's components where it has them
+	void CopySnapshotComponents(const Actor& snapshot);
+
+	// Binary search of the sorted component list, nullptr if the key doesn't exist
+	Component* FindComponent(const std::string& key);
+
+	// Insert keeping components sorted by key
+	void InsertComponent(Component* component);
+
+	void EraseComponent(Component* component);
+
 	void QueueStartFunctions(std::queue<Component*>& functionQueue);
 
 	void Start();
 
 	void ProcessAddedComponents();
 
-	void Update();
-
-	void LateUpdate();
-
 	// TODO: Write InjectConvenienceReferences per slide 26 of discussion 7
 	void InjectConvenienceReferences(Component* component_ref);
 
-	void RefreshAcceleratingStructures();
-
 	//void ReportError(const std::string& actor_name, const luabridge::LuaException& e);
 
 	std::string GetName();
@@ -95,14 +150,14 @@ public:
 	// Obtains reference to component via type.
 	// If multiple components exist of a type, return the first(sorted by component key).
 	// (return nil if no components of the type exist)
-	luabridge::LuaRef GetComponent(const std::string& type_name);
+	luabridge::LuaRef GetComponent(Atom type_name);
 
 	// Obtains reference to all components of type.
 	// (return in the form of an indexed table that may be iterated through with ipairs()).
 	// The components should be returned in sorted order(by their key)
 	// Hint: remember that Lua tables index starting at 1, not 0
 	// (return an empty table if no components of the desired type exist)
-	luabridge::LuaRef GetComponents(const std::string& type_name);
+	luabridge::LuaRef GetComponents(Atom type_name);
 
 	// Add component to actor and return reference to it.
 	// The new component should begin executing lifecycle functions on the next frame.
@@ -115,12 +170,40 @@ public:
 
 	void ProcessRemovedComponents();
 
+	// Updates the scene's tag lists if the actor has started
+	void SetTagMask(uint64_t new_mask);
+
+	// Inactive actors are out of the dispatch lists, systems, event delivery and (through
+	// OnDisable) the physics world. Deactivating is immediate, reactivating happens at the
+	// start of the next scene update so lists aren't modified while they are walked.
+	void SetActive(bool new_active);
+
+	// Put the components into / take them out of the scene's dispatch lists and systems,
+	// calling OnEnable/OnDisable. Only the scene calls these.
+	void EnterDispatch();
+
+	void LeaveDispatch();
+
 	// Mark the actor and all of its components for destruction
 	void Destroy();
 
 	// Remove the actor and all of its components from memory
 	void OnDestroy();
 
+	// True if the destroyed actor can go back to its template's pool: the pool has room and
+	// the actor still has exactly the template's components
+	bool CanReturnToPool();
+
+	// Instead of OnDestroy for pooled actors. Calls OnDisable (OnDestroy if a component has none),
+	// resets every component to the template's values and makes existing handles stale.
+	void Deactivate();
+
+	// Takes an inactive actor back out of the pool as a fresh, not yet active actor
+	void Reuse(int new_id);
+
+	// Instead of Start for reused actors, calls OnEnable (OnStart if a component has none)
+	void Activate();
+
 	void OnCollisionEnter(Collision* collision);
 
 	void OnCollisionExit(Collision* collision);
@@ -128,6 +211,95 @@ public:
 	void OnTriggerEnter(Collision* collision);
 
 	void OnTriggerExit(Collision* collision);
+
+	bool HasCollisionListener(COLLISION_CALLBACK callback) const {
+		return (collision_callback_mask & (1 << callback)) != 0;
+	}
+
+private:
+	void DispatchCollision(COLLISION_CALLBACK callback, const char* function_name, Collision* collision);
+
+	// in_key_order: the component is known to sort after every existing one, so it is appended
+	void AddCollisionListener(Component* component, bool in_key_order);
+
+	void RemoveCollisionListener(Component* component);
 };
 
+// What scripts hold instead of an Actor*. Every actor is allocated from the pool
+// below, and a handle only resolves while its slot's generation still matches,
+// so using an actor after it was destroyed returns nil instead of freed memory.
+class ActorHandle
+{
+public:
+	static inline ENGINE_THREAD_LOCAL SlabPool<Actor> pool;
+
+	uint32_t index = 0;
+	uint32_t generation = 0; // never valid, default handles resolve to nullptr
+
+	ActorHandle() {}
+
+	explicit ActorHandle(Actor* actor);
+
+	// nullptr once the actor has been freed
+	Actor* Get() const;
+
+	// False once the actor is destroyed, even before it is freed at the end of the frame
+	bool IsValid() const;
+
+	bool operator==(const ActorHandle& other) const;
+
+	// Lua facing Actor API, each returns nil if the actor no longer exists
+	luabridge::LuaRef GetName() const;
+
+	luabridge::LuaRef GetID() const;
+
+	luabridge::LuaRef GetComponentByKey(const std::string& key) const;
+
+	luabridge::LuaRef GetComponent(Atom type_name) const;
+
+	luabridge::LuaRef GetComponents(Atom type_name) const;
+
+	luabridge::LuaRef AddComponent(const std::string& type_name) const;
+
+	void RemoveComponent(const luabridge::LuaRef& component_ref) const;
+
+	void SetActive(bool active) const;
+
+	bool IsActive() const;
+
+	void AddTag(Atom tag) const;
+
+	void RemoveTag(Atom tag) const;
+
+	bool HasTag(Atom tag) const;
+
+	luabridge::LuaRef GetTagMask() const;
+};
+
+namespace luabridge {
+	// Actor* crosses into lua as an ActorHandle and comes back out through the
+	// generation check, nullptr if the actor is gone
+	template <>
+	struct Stack<Actor*> {
+		static void push(lua_State* lua_state, Actor* actor) {
+			if (actor == nullptr)
+				lua_pushnil(lua_state);
+			else
+				Stack<ActorHandle>::push(lua_state, ActorHandle(actor));
+		}
+
+		static Actor* get(lua_State* lua_state, int index) {
+			if (lua_isnil(lua_state, index))
+				return nullptr;
+
+			ActorHandle* handle = detail::Userdata::get<ActorHandle>(lua_state, index, true);
+			return handle != nullptr ? handle->Get() : nullptr;
+		}
+
+		static bool isInstance(lua_State* lua_state, int index) {
+			return lua_isnil(lua_state, index) || detail::Userdata::isInstance<ActorHandle>(lua_state, index);
+		}
+	};
+}
+
 #endif
\ No newline at end of file
@@ -1,17 +1,33 @@
 #include "game.h"
 #include "Rigidbody.h"
 #include "EventBus.h"
-
-void Game::Init() {
-	renderer = &Renderer::getInstance();
+#include "ErrorLog.h"
+#include "Timer.h"
+#include "Tween.h"
+#include "TagDB.h"
+
+void Game::Init(bool headless) {
+	GameData::headless = headless;
+	if (!headless)
+		renderer = &Renderer::getInstance();
 	GameData& data = GameData::getInstance();
 	ImageDB& imageDB = ImageDB::getInstance();
+	ErrorLog::Init();
 	ImageDB::Init();
-	TextDB::Init();
-	AudioDB::Init();
-	Input::Init();
+	if (!headless) {
+		TextDB::Init();
+		AudioDB::Init();
+		Input::Init();
+	}
 	ComponentManager::Init();
 
+	if (data.gameConfig.HasMember("cell_size") && data.gameConfig["cell_size"].IsNumber())
+		GameData::CELL_SIZE = data.gameConfig["cell_size"].GetFloat();
+	if (data.gameConfig.HasMember("stream_radius") && data.gameConfig["stream_radius"].IsInt())
+		GameData::STREAM_RADIUS = data.gameConfig["stream_radius"].GetInt();
+	if (data.gameConfig.HasMember("stream_budget_ms") && data.gameConfig["stream_budget_ms"].IsNumber())
+		GameData::STREAM_BUDGET_MS = data.gameConfig["stream_budget_ms"].GetFloat();
+
 	if (data.gameConfig.HasMember("initial_scene")) {
 		std::string name = data.gameConfig["initial_scene"].GetString();
 		next_scene = name;
@@ -28,17 +44,35 @@ void Game::RunGame() {
 		SDL_RenderClear(Renderer::renderer);
 		Update();
 		EventBus::ProcessSubscriptions();
+		Timer::Step();
+		Tween::Step();
 		Rigidbody::Step();
 		Renderer::Render();
 		Helper::SDL_RenderPresent(Renderer::renderer);
 		if (proceed_to_next_scene)
 			LoadScene(next_scene);
 		Input::LateUpdate();
+		ErrorLog::EndFrame();
 	}
 
 	return;
 }
 
+void Game::RunHeadless(int frames) {
+	for (int frame = 0; frame < frames && !input_quit; frame++) {
+		Update();
+		EventBus::ProcessSubscriptions();
+		Timer::Step();
+		Tween::Step();
+		Rigidbody::Step();
+		Renderer::ClearRequests();
+		GameData::headless_frame_number++;
+		if (proceed_to_next_scene)
+			LoadScene(next_scene);
+		ErrorLog::EndFrame();
+	}
+}
+
 void Game::ProcessInput() {
 	SDL_Event event;
 	while (Helper::SDL_PollEvent(&event)) {
@@ -48,6 +82,7 @@ void Game::ProcessInput() {
 }
 
 void Game::Update() {
+	currentScene->UpdateStreaming(Renderer::camera.GetPositionX(), Renderer::camera.GetPositionY());
 	currentScene->UpdateActors();
 }
 
@@ -55,18 +90,42 @@ void Game::LateUpdate() {
 	currentScene->LateUpdate();
 }
 
-luabridge::LuaRef Game::Find(const std::string& name) {
+luabridge::LuaRef Game::Find(Atom name) {
 	return currentScene->Find(name);
 }
 
-luabridge::LuaRef Game::FindAll(const std::string& name) {
+luabridge::LuaRef Game::FindAll(Atom name) {
 	return currentScene->FindAll(name);
 }
 
+luabridge::LuaRef Game::FindByTag(Atom tag) {
+	return currentScene->FindByTag(tag);
+}
+
+luabridge::LuaRef Game::FindByMask(const luabridge::LuaRef& tags, bool match_all) {
+	return currentScene->FindByMask(TagDB::MaskFromLua(tags), match_all);
+}
+
+luabridge::LuaRef Game::FindInRadius(float x, float y, float radius, luabridge::LuaRef name) {
+	return currentScene->FindInRadius(x, y, radius, name);
+}
+
+luabridge::LuaRef Game::FindInRect(float min_x, float min_y, float max_x, float max_y, luabridge::LuaRef name) {
+	return currentScene->FindInRect(min_x, min_y, max_x, max_y, name);
+}
+
+luabridge::LuaRef Game::FindNearest(float x, float y, luabridge::LuaRef name, luabridge::LuaRef max_radius) {
+	return currentScene->FindNearest(x, y, name, max_radius);
+}
+
 luabridge::LuaRef Game::Instantiate(const std::string& actor_template_name) {
 	return currentScene->Instantiate(actor_template_name);
 }
 
+luabridge::LuaRef Game::InstantiateMany(const std::string& actor_template_name, int count, luabridge::LuaRef initializer) {
+	return currentScene->InstantiateMany(actor_template_name, count, initializer);
+}
+
 void Game::Destroy(Actor* actor) {
 	return currentScene->Destroy(actor);
 }
@@ -111,6 +170,10 @@ void Game::QueueSceneLoad(std::string sceneName) {
 	next_scene = sceneName;
 }
 
+void Game::QueueSceneRestore() {
+	QueueSceneLoad(currentScene->GetSceneName());
+}
+
 void Game::LoadScene(std::string sceneName) {
 	proceed_to_next_scene = false;
 
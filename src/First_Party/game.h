@@ -17,13 +17,13 @@ using Clock = std::chrono::steady_clock;
 class Game
 {
 public:
-	static inline Renderer* renderer = nullptr;
+	static inline ENGINE_THREAD_LOCAL Renderer* renderer = nullptr;
 	
-	static inline Scene* currentScene = nullptr;
+	static inline ENGINE_THREAD_LOCAL Scene* currentScene = nullptr;
 
-	static inline bool proceed_to_next_scene = false;
+	static inline ENGINE_THREAD_LOCAL bool proceed_to_next_scene = false;
 
-	static inline std::string next_scene = "";
+	static inline ENGINE_THREAD_LOCAL std::string next_scene = "";
 
 	static inline const Clock::time_point startTime = Clock::now();
 
@@ -33,29 +33,45 @@ public:
 
 	//bool gameOver;
 
-	static inline bool input_quit;
+	static inline ENGINE_THREAD_LOCAL bool input_quit;
 
 	static Game& getInstance() {
 		static Game instance; // Guaranteed to be created only once
 		return instance;
 	}
 
-	static void Init();
+	// A headless game opens no window, audio device or input and draws nothing
+	static void Init(bool headless = false);
 
 	static void RunGame();
 
+	// Runs frames frames of a headless game as fast as possible
+	static void RunHeadless(int frames);
+
 	static void ProcessInput();
 
 	static void Update();
 
 	static void LateUpdate();
 
-	static luabridge::LuaRef Find(const std::string& name);
+	static luabridge::LuaRef Find(Atom name);
+
+	static luabridge::LuaRef FindAll(Atom name);
+
+	static luabridge::LuaRef FindByTag(Atom tag);
+
+	static luabridge::LuaRef FindByMask(const luabridge::LuaRef& tags, bool match_all);
 
-	static luabridge::LuaRef FindAll(const std::string& name);
+	static luabridge::LuaRef FindInRadius(float x, float y, float radius, luabridge::LuaRef name);
+
+	static luabridge::LuaRef FindInRect(float min_x, float min_y, float max_x, float max_y, luabridge::LuaRef name);
+
+	static luabridge::LuaRef FindNearest(float x, float y, luabridge::LuaRef name, luabridge::LuaRef max_radius);
 
 	static luabridge::LuaRef Instantiate(const std::string& actor_template_name);
 
+	static luabridge::LuaRef InstantiateMany(const std::string& actor_template_name, int count, luabridge::LuaRef initializer);
+
 	static void Destroy(Actor* actor);
 
 	static void Quit();
@@ -68,6 +84,9 @@ public:
 
 	static void QueueSceneLoad(std::string sceneName);
 
+	// Restarts the current scene from its snapshot at the end of the frame
+	static void QueueSceneRestore();
+
 	static void LoadScene(std::string sceneName);
 
 	static std::string GetCurrentSceneName();
@@ -10,23 +10,34 @@
 class GameData {
 public:
 	// Define an unordered_map
-	static inline std::unordered_map<std::string, std::string> messages;
+	static inline ENGINE_THREAD_LOCAL std::unordered_map<std::string, std::string> messages;
 
     // Access with hasMember()
-	static inline rapidjson::Document gameConfig;
-    static inline rapidjson::Document renderingConfig;
+	static inline ENGINE_THREAD_LOCAL rapidjson::Document gameConfig;
+    static inline ENGINE_THREAD_LOCAL rapidjson::Document renderingConfig;
 
-    static inline bool renderingConfigExists = false;
+    static inline ENGINE_THREAD_LOCAL bool renderingConfigExists = false;
 
-    static inline int CAMERA_WIDTH = 13;
-    static inline int CAMERA_HEIGHT = 9;
-    static inline int CAMERA_HALF_WIDTH = 6;
-    static inline int CAMERA_HALF_HEIGHT = 4;
+    static inline ENGINE_THREAD_LOCAL int CAMERA_WIDTH = 13;
+    static inline ENGINE_THREAD_LOCAL int CAMERA_HEIGHT = 9;
+    static inline ENGINE_THREAD_LOCAL int CAMERA_HALF_WIDTH = 6;
+    static inline ENGINE_THREAD_LOCAL int CAMERA_HALF_HEIGHT = 4;
 
-    static inline float CELL_SIZE = 100.0f;
+    // World units per spatial hash cell, "cell_size" in game.config
+    static inline ENGINE_THREAD_LOCAL float CELL_SIZE = 4.0f;
 
-    static inline int UUID = 0;
-    static inline int CallsToAddComponent = 0;
+    // Chunks of chunked scenes within this many chunks of the camera are loaded, "stream_radius" in game.config
+    static inline ENGINE_THREAD_LOCAL int STREAM_RADIUS = 2;
+    // Milliseconds per frame spent instantiating chunk actors, "stream_budget_ms" in game.config
+    static inline ENGINE_THREAD_LOCAL float STREAM_BUDGET_MS = 2.0f;
+
+    // Set by Game::Init for games that run without a window, audio or input
+    static inline ENGINE_THREAD_LOCAL bool headless = false;
+    // Frames run by a headless game, windowed games count presented frames through Helper
+    static inline ENGINE_THREAD_LOCAL int headless_frame_number = 0;
+
+    static inline ENGINE_THREAD_LOCAL int UUID = 0;
+    static inline ENGINE_THREAD_LOCAL int CallsToAddComponent = 0;
 
     // Public method to access the single instance of the class
     static GameData& getInstance() {
@@ -34,6 +45,10 @@ public:
         return instance;
     }
 
+    static int GetFrameNumber() {
+        return headless ? headless_frame_number : Helper::GetFrameNumber();
+    }
+
     static void ReadRenderingConfig() {
         renderingConfigExists = true;
 
@@ -1,15 +1,24 @@
 #include "game.h"
 #include "gameData.h"
 #include <filesystem>
+#include <thread>
 
 void CheckDependencies();
 void ReadConfigs();
+void RunHeadlessGames(int frames, int instances);
 
 namespace fs = std::filesystem;
 
 int main(int argc, char* argv[]) {
 
 	CheckDependencies();
+
+	// game_engine --headless <frames> [instances]
+	if (argc >= 3 && std::string(argv[1]) == "--headless") {
+		RunHeadlessGames(std::atoi(argv[2]), argc >= 4 ? std::atoi(argv[3]) : 1);
+		return 0;
+	}
+
 	ReadConfigs();
 
 	Game::Init();
@@ -19,6 +28,28 @@ int main(int argc, char* argv[]) {
 	return 0;
 }
 
+void RunHeadlessGames(int frames, int instances) {
+#ifndef ENGINE_MULTI_INSTANCE
+	if (instances > 1) {
+		std::cout << "error: running more than one headless instance requires building with ENGINE_MULTI_INSTANCE";
+		exit(0);
+	}
+#endif
+
+	// Engine state is per thread, so each instance reads its own configs and runs its own game
+	std::vector<std::thread> games;
+	for (int i = 0; i < instances; i++) {
+		games.emplace_back([frames]() {
+			ReadConfigs();
+			Game::Init(true);
+			Game::RunHeadless(frames);
+		});
+	}
+
+	for (std::thread& game : games)
+		game.join();
+}
+
 void CheckDependencies() {
 	// Get the path of the current executable
 	fs::path exePath = fs::current_path();
@@ -63,6 +63,9 @@ void Renderer::DrawUIEx(std::string image, float x, float y, float r, float g, f
 }
 
 void Renderer::DrawImage(std::string image, float x, float y) {
+	// Headless games have no textures to draw with
+	if (GameData::headless)
+		return;
 
 	glm::vec2 final_rendering_position = glm::vec2(x, y) - CameraGetPosition();
 
@@ -105,6 +108,8 @@ void Renderer::DrawImage(std::string image, float x, float y) {
 void Renderer::DrawImageEx(std::string image, float x, float y, float rotation_degrees,
 	float scale_x, float scale_y, float pivot_x, float pivot_y,
 	float r, float g, float b, float a, float sorting_order) {
+	if (GameData::headless)
+		return;
 
 	glm::vec2 final_rendering_position = glm::vec2(x, y) - CameraGetPosition();
 
@@ -152,6 +157,8 @@ void Renderer::DrawImageEx(std::string image, float x, float y, float rotation_d
 void Renderer::DrawParticleEx(std::string image, float x, float y, float rotation_degrees,
 	float scale_x, float scale_y, float pivot_x, float pivot_y,
 	uint8_t r, uint8_t g, uint8_t b, uint8_t a, int sorting_order) {
+	if (GameData::headless)
+		return;
 
 	glm::vec2 final_rendering_position = glm::vec2(x, y) - CameraGetPosition();
 
@@ -194,6 +201,13 @@ void Renderer::DrawParticleEx(std::string image, float x, float y, float rotatio
 	//image_render_requests.emplace_back(image, color, x, y, sorting_order, static_cast<int>(rotation_degrees), scale_x, scale_y, pivot_x, pivot_y);
 }
 
+void Renderer::ClearRequests() {
+	text_render_requests.clear();
+	ui_render_requests.clear();
+	image_render_requests.clear();
+	pixel_render_requests.clear();
+}
+
 void Renderer::DrawPixel(float x, float y, float r, float g, float b, float a) {
 	SDL_Color color = { static_cast<Uint8>(r), static_cast<Uint8>(g), static_cast<Uint8>(b), static_cast<Uint8>(a) };
 	pixel_render_requests.emplace_back(static_cast<int>(x), static_cast<int>(y), color);
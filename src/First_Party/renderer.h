@@ -37,23 +37,23 @@ public:
 class Renderer
 {
 public:
-	static inline SDL_Window* window = nullptr;
-	static inline SDL_Renderer* renderer = nullptr;
+	static inline ENGINE_THREAD_LOCAL SDL_Window* window = nullptr;
+	static inline ENGINE_THREAD_LOCAL SDL_Renderer* renderer = nullptr;
 
-	static inline Camera camera;
+	static inline ENGINE_THREAD_LOCAL Camera camera;
 
-	static inline std::vector<TextRenderRequest> text_render_requests;
-	static inline std::vector<UIRenderRequest> ui_render_requests;
-	static inline std::vector<ImageRenderRequest> image_render_requests;
-	static inline std::vector<PixelRenderRequest> pixel_render_requests;
+	static inline ENGINE_THREAD_LOCAL std::vector<TextRenderRequest> text_render_requests;
+	static inline ENGINE_THREAD_LOCAL std::vector<UIRenderRequest> ui_render_requests;
+	static inline ENGINE_THREAD_LOCAL std::vector<ImageRenderRequest> image_render_requests;
+	static inline ENGINE_THREAD_LOCAL std::vector<PixelRenderRequest> pixel_render_requests;
 
-	static inline int clear_color_r;
-	static inline int clear_color_g;
-	static inline int clear_color_b;
+	static inline ENGINE_THREAD_LOCAL int clear_color_r;
+	static inline ENGINE_THREAD_LOCAL int clear_color_g;
+	static inline ENGINE_THREAD_LOCAL int clear_color_b;
 
 	TTF_Font* font = nullptr;
 
-	static inline std::string fontName;
+	static inline ENGINE_THREAD_LOCAL std::string fontName;
 
 
 	Renderer() {
@@ -108,6 +108,9 @@ public:
 
 	static void Render();
 
+	// Drops this frame's draw requests without rendering them, for headless games
+	static void ClearRequests();
+
 	static void DrawText(const std::string text, const float x, const float y, const char* font,
 		const float fontSize, const float r, const float g, const float b, const float a);
 
@@ -1,33 +1,148 @@
 #include "scene.h"
+#include "SystemManager.h"
+#include "NativeComponent.h"
+#include <chrono>
 
 Scene::Scene(rapidjson::Document& sceneDoc, std::string sceneName) {
 	//GameData& data = GameData::getInstance();
 	//TemplateDB& templates = TemplateDB::getInstance();
 	scene_name = sceneName;
 
-	const auto& actorsArray = sceneDoc["actors"].GetArray();
+	// Chunked scenes may leave the actors list out entirely
+	if (sceneDoc.HasMember("actors") && sceneDoc["actors"].IsArray()) {
+		const auto& actorsArray = sceneDoc["actors"].GetArray();
 
-	int numActors = actorsArray.Size();
+		int numActors = actorsArray.Size();
 
-	actors.reserve(numActors * 2);
+		actors.reserve(numActors * 2);
 
+		for (const auto& actor : actorsArray)
+			CreateFromJson(actor);
+	}
+
+	// Chunked scenes keep the parsed file around, chunk actors are created from it as the camera gets close
+	if (sceneDoc.HasMember("chunks") && sceneDoc["chunks"].IsArray()) {
+		if (sceneDoc.HasMember("chunk_size") && sceneDoc["chunk_size"].IsNumber())
+			chunk_size = sceneDoc["chunk_size"].GetFloat();
+		if (chunk_size <= 0.0f)
+			chunk_size = 32.0f;
+
+		chunk_document = std::make_shared<rapidjson::Document>();
+		chunk_document->Swap(sceneDoc);
+
+		const auto& chunksArray = (*chunk_document)["chunks"].GetArray();
+		chunks.reserve(chunksArray.Size());
+		for (const auto& chunk : chunksArray) {
+			if (!chunk.IsObject() || !chunk.HasMember("actors") || !chunk["actors"].IsArray())
+				continue;
+
+			SceneChunk& newChunk = chunks.emplace_back();
+			newChunk.x = chunk.HasMember("x") && chunk["x"].IsInt() ? chunk["x"].GetInt() : 0;
+			newChunk.y = chunk.HasMember("y") && chunk["y"].IsInt() ? chunk["y"].GetInt() : 0;
+			newChunk.actors = &chunk["actors"];
+		}
+	}
+}
+
+Actor* Scene::CreateFromJson(const rapidjson::Value& actor) {
 	Actor* newActor = nullptr;
 
-	for (const auto& actor : actorsArray) {
-		// In the case the actor is templated from another, read in the template 
-		// first and make sure it exists
-		if (actor.HasMember("template") && actor["template"].IsString()) {
-			Actor* templatedActor = TemplateDB::GetTemplate(actor["template"].GetString());
-			// Use template copy constructor to make new actor
-			newActor = new Actor(templatedActor, actor, GameData::GetUUID());
+	// In the case the actor is templated from another, read in the template 
+	// first and make sure it exists
+	if (actor.HasMember("template") && actor["template"].IsString()) {
+		Actor* templatedActor = TemplateDB::GetTemplate(actor["template"].GetString());
+		// Use template copy constructor to make new actor
+		newActor = ActorHandle::pool.Create(templatedActor, actor, GameData::GetUUID());
+	}
+	else {
+		newActor = ActorHandle::pool.Create(actor, GameData::GetUUID());
+	}
+
+	//actors.emplace_back(newActor);
+	actors_to_add.emplace_back(newActor);
+	findActors[newActor->name_id].emplace_back(newActor);
+
+	return newActor;
+}
+
+void Scene::UpdateStreaming(float camera_x, float camera_y) {
+	if (chunks.empty())
+		return;
+
+	int chunk_x = static_cast<int>(std::floor(camera_x / chunk_size));
+	int chunk_y = static_cast<int>(std::floor(camera_y / chunk_size));
+	if (chunk_x != camera_chunk_x || chunk_y != camera_chunk_y) {
+		camera_chunk_x = chunk_x;
+		camera_chunk_y = chunk_y;
+		RefreshChunks();
+	}
+
+	if (!chunks_to_load.empty())
+		LoadQueuedChunks();
+}
+
+void Scene::RefreshChunks() {
+	int radius = GameData::STREAM_RADIUS;
+
+	for (int i = 0; i < static_cast<int>(chunks.size()); i++) {
+		SceneChunk& chunk = chunks[i];
+		int distance = std::max(std::abs(chunk.x - camera_chunk_x), std::abs(chunk.y - camera_chunk_y));
+
+		if (distance <= radius && !chunk.active) {
+			chunk.active = true;
+			for (const ActorHandle& actor : chunk.spawned)
+				actor.SetActive(true);
+
+			if (!chunk.queued && chunk.next_actor < chunk.actors->Size()) {
+				chunk.queued = true;
+				chunks_to_load.push_back(i);
+			}
 		}
-		else {
-			newActor = new Actor(actor, GameData::GetUUID());
+		// One chunk of slack so walking along a chunk border doesn't toggle it every frame
+		else if (distance > radius + 1 && chunk.active) {
+			chunk.active = false;
+			for (const ActorHandle& actor : chunk.spawned)
+				actor.SetActive(false);
 		}
+	}
 
-		//actors.emplace_back(newActor);
-		actors_to_add.emplace_back(newActor);
-		findActors[newActor->name].emplace_back(newActor);
+	std::sort(chunks_to_load.begin(), chunks_to_load.end(), [&](int a, int b) {
+		int distance_a = std::max(std::abs(chunks[a].x - camera_chunk_x), std::abs(chunks[a].y - camera_chunk_y));
+		int distance_b = std::max(std::abs(chunks[b].x - camera_chunk_x), std::abs(chunks[b].y - camera_chunk_y));
+		return distance_a < distance_b;
+	});
+}
+
+void Scene::LoadQueuedChunks() {
+	using StreamClock = std::chrono::steady_clock;
+	StreamClock::time_point deadline = StreamClock::now() +
+		std::chrono::microseconds(static_cast<long long>(GameData::STREAM_BUDGET_MS * 1000.0f));
+
+	// At least one actor per frame, so a tiny budget still makes progress
+	bool created_any = false;
+
+	while (!chunks_to_load.empty()) {
+		SceneChunk& chunk = chunks[chunks_to_load.front()];
+
+		// Chunks the camera left before they finished wait until it comes back
+		if (!chunk.active) {
+			chunk.queued = false;
+			chunks_to_load.pop_front();
+			continue;
+		}
+
+		const rapidjson::Value& chunkActors = *chunk.actors;
+		while (chunk.next_actor < chunkActors.Size()) {
+			if (created_any && StreamClock::now() >= deadline)
+				return;
+
+			chunk.spawned.emplace_back(CreateFromJson(chunkActors[chunk.next_actor]));
+			chunk.next_actor++;
+			created_any = true;
+		}
+
+		chunk.queued = false;
+		chunks_to_load.pop_front();
 	}
 }
 
@@ -37,10 +152,21 @@ Scene::Scene(const Scene& other, std::string sceneName) {
 	actors.reserve(other.actors_to_add.size() * 2);
 
 	for (Actor* actor : other.actors_to_add) {
-		Actor* newActor = new Actor(actor, GameData::GetUUID());
+		Actor* newActor = ActorHandle::pool.Create(*actor, GameData::GetUUID());
 		//actors.emplace_back(newActor);
 		actors_to_add.emplace_back(newActor);
-		findActors[newActor->name].emplace_back(newActor);
+		findActors[newActor->name_id].emplace_back(newActor);
+	}
+
+	// Chunks share the snapshot's parsed file and start out unloaded
+	chunk_document = other.chunk_document;
+	chunk_size = other.chunk_size;
+	chunks.reserve(other.chunks.size());
+	for (const SceneChunk& chunk : other.chunks) {
+		SceneChunk& newChunk = chunks.emplace_back();
+		newChunk.x = chunk.x;
+		newChunk.y = chunk.y;
+		newChunk.actors = chunk.actors;
 	}
 }
 
@@ -48,68 +174,284 @@ std::string Scene::GetSceneName() {
 	return scene_name;
 }
 
-void Scene::UpdateActors() {
-	// TODO OPT Use accelerating data structures to keep track of actors with an onUpdate
-	// component, instead of looping through all actors. The difficulty comes in keeping 
-	// these up to date when actors can add/remove components from themselves or others
+// Runs lifecycle on every enabled component in the dispatch list
+static void RunDispatch(std::vector<DispatchEntry>& dispatch, COMPONENT_LIFECYCLE lifecycle) {
+	for (const DispatchEntry& entry : dispatch) {
+		Component* component = entry.component;
+		if (component == nullptr || !component->IsEnabled())
+			continue;
+
+		ComponentManager::CallLifecycle(component, lifecycle, entry.actor->name);
+	}
+}
 
+void Scene::UpdateActors() {
 	if (!actors_to_add.empty()) {
 		// In case actors get added in start functions
 		std::vector<Actor*> new_actors = actors_to_add;
 		actors_to_add.clear();
 
 		for (Actor* actor : new_actors) {
-			actor->Start();
-			actors.emplace_back(actor);
+			if (actor->destroyed) {
+				// Its OnDestroy already ran in Destroy, it only needs to leave the name index before its
+				// slot is freed. Checked here, an earlier actor's OnStart may have destroyed it this pass.
+				if (destroyed_pending_count > 0) {
+					CompactFindActors();
+					destroyed_pending_count = 0;
+				}
+				ActorHandle::pool.Release(actor);
+				continue;
+			}
+
+			// Appended before Start so an actor that destroys itself in OnStart is tracked
+			AppendActor(actor);
+			if (!actor->active)
+				continue; // Starts when it is activated
+			if (actor->started)
+				actor->Activate(); // Reused from its template's pool
+			else
+				actor->Start();
 		}
 	}
 
-	for (Actor* actor : actors)
-		actor->ProcessAddedComponents();
+	// Index loop, OnEnable may activate more actors which are processed this pass too
+	for (size_t i = 0; i < actors_to_activate.size(); i++) {
+		Actor* actor = actors_to_activate[i].Get();
+		if (actor != nullptr && actor->active && !actor->in_dispatch && actor->scene == this && !actor->destroyed)
+			actor->EnterDispatch();
+	}
+	actors_to_activate.clear();
+
+	// Index loops, OnStart/OnDestroy may queue more actors which are processed this pass too
+	for (size_t i = 0; i < actors_with_added_components.size(); i++) {
+		Actor* actor = actors_with_added_components[i].Get();
+		if (actor != nullptr)
+			actor->ProcessAddedComponents();
+	}
+	actors_with_added_components.clear();
 
-	for (Actor* actor : actors)
-		actor->Update();
+	RunDispatch(update_dispatch, COMPONENT_LIFECYCLE_UPDATE);
+
+	SystemManager::RunSystems();
 
 	LateUpdate();
 
-	for (Actor* actor : actors)
-		actor->ProcessRemovedComponents();
+	for (size_t i = 0; i < actors_with_removed_components.size(); i++) {
+		Actor* actor = actors_with_removed_components[i].Get();
+		if (actor != nullptr)
+			actor->ProcessRemovedComponents();
+	}
+	actors_with_removed_components.clear();
+
+	if (destroyed_count > 0)
+		CompactDestroyedActors();
+	else if (removed_dispatch_count > 0)
+		CompactDispatch();
+}
 
-	if (!actors_to_destroy.empty()) {
-		// Loop backwards to avoid messing up any indices
-		for (int i = (int)actors_to_destroy.size() - 1; i >= 0; i--) {
-			Actor* actor_to_destroy = actors[actors_to_destroy[i]];
+void Scene::AppendActor(Actor* actor) {
+	actor->scene = this;
+	actor->scene_index = static_cast<int>(actors.size());
+	actors.emplace_back(actor);
+	destroyed_mask.emplace_back(0);
+
+	// Inactive actors join the dispatch lists when they are activated
+	actor->in_dispatch = actor->active;
+
+	// The actor is last in the scene, so its components go at the end of the dispatch lists
+	for (Component* component : actor->components) {
+		if (!actor->in_dispatch)
+			break;
+		if (component->hasUpdate)
+			update_dispatch.push_back({ actor, component });
+		if (component->hasLateUpdate)
+			late_update_dispatch.push_back({ actor, component });
+	}
 
-			RemoveFromFindActors(actor_to_destroy);
+	// Components added before the actor started
+	if (!actor->added_components.empty())
+		actors_with_added_components.emplace_back(actor);
 
-			if (actor_to_destroy->dontDestroyOnLoad) {
-				DDOL_actors_in_scene.erase(actor_to_destroy);
-			}
-			actor_to_destroy->OnDestroy();
-			delete actor_to_destroy;
-			actors.erase(actors.begin() + actors_to_destroy[i]);
+	// Components removed before the actor joined, RemoveComponent had no scene to queue it with
+	if (!actor->removed_components.empty())
+		actors_with_removed_components.emplace_back(actor);
+
+	for (uint64_t mask = actor->tag_mask; mask != 0; mask &= mask - 1)
+		tagged_actors[TagDB::LowestBit(mask)].push_back(actor);
+}
+
+void Scene::UpdateTagLists(Actor* actor, uint64_t old_mask, uint64_t new_mask) {
+	for (uint64_t added = new_mask & ~old_mask; added != 0; added &= added - 1)
+		tagged_actors[TagDB::LowestBit(added)].push_back(actor);
+
+	for (uint64_t removed = old_mask & ~new_mask; removed != 0; removed &= removed - 1) {
+		std::vector<Actor*>& tag_list = tagged_actors[TagDB::LowestBit(removed)];
+		auto it = std::find(tag_list.begin(), tag_list.end(), actor);
+		if (it != tag_list.end())
+			tag_list.erase(it);
+	}
+}
+
+void Scene::RebuildTagLists() {
+	for (std::vector<Actor*>& tag_list : tagged_actors)
+		tag_list.clear();
+
+	for (Actor* actor : actors) {
+		for (uint64_t mask = actor->tag_mask; mask != 0; mask &= mask - 1)
+			tagged_actors[TagDB::LowestBit(mask)].push_back(actor);
+	}
+}
+
+// First entry belonging to actor (or the position it would go), found by the actor's scene index
+static std::vector<DispatchEntry>::iterator FindActorEntries(std::vector<DispatchEntry>& dispatch, Actor* actor) {
+	return std::lower_bound(dispatch.begin(), dispatch.end(), actor->scene_index,
+		[](const DispatchEntry& entry, int scene_index) { return entry.actor->scene_index < scene_index; });
+}
+
+static void InsertDispatchEntry(std::vector<DispatchEntry>& dispatch, Actor* actor, Component* component) {
+	auto it = FindActorEntries(dispatch, actor);
+
+	// An actor only has a few entries, walk them to keep key order
+	while (it != dispatch.end() && it->actor == actor &&
+		(it->component == nullptr || it->component->key < component->key)) {
+		++it;
+	}
+
+	dispatch.insert(it, { actor, component });
+}
+
+static bool ClearDispatchEntry(std::vector<DispatchEntry>& dispatch, Actor* actor, Component* component) {
+	for (auto it = FindActorEntries(dispatch, actor); it != dispatch.end() && it->actor == actor; ++it) {
+		if (it->component == component) {
+			it->component = nullptr;
+			return true;
 		}
+	}
+	return false;
+}
+
+void Scene::AddToDispatch(Actor* actor, Component* component) {
+	if (component->hasUpdate)
+		InsertDispatchEntry(update_dispatch, actor, component);
+	if (component->hasLateUpdate)
+		InsertDispatchEntry(late_update_dispatch, actor, component);
+}
+
+void Scene::RemoveFromDispatch(Actor* actor, Component* component) {
+	// Cleared rather than erased so removing many components costs one compaction
+	if (component->hasUpdate && ClearDispatchEntry(update_dispatch, actor, component))
+		removed_dispatch_count++;
+	if (component->hasLateUpdate && ClearDispatchEntry(late_update_dispatch, actor, component))
+		removed_dispatch_count++;
+}
+
+void Scene::CompactDispatch() {
+	auto is_dead = [](const DispatchEntry& entry) {
+		return entry.component == nullptr || entry.actor->destroyed;
+	};
+
+	update_dispatch.erase(std::remove_if(update_dispatch.begin(), update_dispatch.end(), is_dead), update_dispatch.end());
+	late_update_dispatch.erase(std::remove_if(late_update_dispatch.begin(), late_update_dispatch.end(), is_dead), late_update_dispatch.end());
 
-		actors_to_destroy.clear();
+	removed_dispatch_count = 0;
+}
+
+void Scene::RebuildDispatch() {
+	update_dispatch.clear();
+	late_update_dispatch.clear();
+	removed_dispatch_count = 0;
+
+	for (Actor* actor : actors) {
+		if (!actor->in_dispatch)
+			continue;
+
+		for (Component* component : actor->components) {
+			if (component->hasUpdate)
+				update_dispatch.push_back({ actor, component });
+			if (component->hasLateUpdate)
+				late_update_dispatch.push_back({ actor, component });
+		}
 	}
 }
 
-void Scene::LateUpdate() {
-	// TODO OPT Use accelerating data structures to keep track of actors with an onUpdate
-	// component, instead of looping through all actors. The difficulty comes in keeping 
-	// these up to date when actors can add/remove components from themselves or others
+void Scene::CompactDestroyedActors() {
+	static ENGINE_THREAD_LOCAL std::vector<Actor*> dead_actors;
+
+	// Must run while the destroyed actors still hold their old scene indices
+	CompactDispatch();
 
-	for (Actor* actor : actors)
-		actor->LateUpdate();
+	size_t write_index = 0;
+	bool destroyed_ddol = false;
+	uint64_t destroyed_tags = 0;
+
+	for (size_t read_index = 0; read_index < actors.size(); read_index++) {
+		Actor* actor = actors[read_index];
+
+		if (destroyed_mask[read_index]) {
+			dead_actors.emplace_back(actor);
+			destroyed_ddol |= actor->dontDestroyOnLoad;
+			destroyed_tags |= actor->tag_mask;
+			continue;
+		}
+
+		actor->scene_index = static_cast<int>(write_index);
+		actors[write_index] = actor;
+		destroyed_mask[write_index] = 0;
+		write_index++;
+	}
+
+	actors.resize(write_index);
+	destroyed_mask.resize(write_index);
+	destroyed_count = 0;
+
+	CompactFindActors();
+
+	// One stable pass per tag any destroyed actor had
+	for (; destroyed_tags != 0; destroyed_tags &= destroyed_tags - 1) {
+		std::vector<Actor*>& tag_list = tagged_actors[TagDB::LowestBit(destroyed_tags)];
+		tag_list.erase(std::remove_if(tag_list.begin(), tag_list.end(),
+			[](Actor* actor) { return actor->destroyed; }), tag_list.end());
+	}
+
+	if (destroyed_ddol) {
+		dont_destroy_on_load_actors.erase(std::remove_if(dont_destroy_on_load_actors.begin(), dont_destroy_on_load_actors.end(),
+			[](Actor* actor) { return actor->destroyed; }), dont_destroy_on_load_actors.end());
+	}
+
+	// The grid may point at the actors freed below
+	spatial_hash.Invalidate();
+
+	// OnDestroy may destroy more actors, those are picked up by next frame's pass
+	for (Actor* actor : dead_actors) {
+		if (actor->dontDestroyOnLoad) {
+			DDOL_actors_in_scene.erase(actor);
+		}
+		actor->scene = nullptr;
+		actor->scene_index = -1;
+
+		if (actor->CanReturnToPool()) {
+			actor->Deactivate();
+			actor->actor_template->pool->inactive.emplace_back(actor);
+			continue;
+		}
+
+		actor->OnDestroy();
+		ActorHandle::pool.Release(actor);
+	}
+
+	dead_actors.clear();
 }
 
-luabridge::LuaRef Scene::Find(const std::string & name) {
-	if (findActors.find(name) != findActors.end()) {
-		if (findActors[name].size() != 0) {
-			for (Actor* actor : findActors[name]) {
-				if (!actor->destroyed)
-					return luabridge::LuaRef(ComponentManager::GetLuaState(), actor);
-			}
+void Scene::LateUpdate() {
+	RunDispatch(late_update_dispatch, COMPONENT_LIFECYCLE_LATE_UPDATE);
+}
+
+luabridge::LuaRef Scene::Find(Atom name) {
+	auto actors_with_name = findActors.find(name);
+	if (actors_with_name != findActors.end()) {
+		for (Actor* actor : actors_with_name->second) {
+			if (!actor->destroyed)
+				return luabridge::LuaRef(ComponentManager::GetLuaState(), actor);
 		}
 	}
 
@@ -132,19 +474,120 @@ luabridge::LuaRef Scene::Find(const std::string & name) {
 	return luabridge::LuaRef(ComponentManager::GetLuaState()); // returns nil to lua if none found
 }
 
-luabridge::LuaRef Scene::FindAll(const std::string & name) {
+// Optional filter argument of the spatial queries: an actor name, or tags (a mask or
+// table of tag names) of which the actor needs at least one. nil matches everything.
+static SpatialFilter ReadSpatialFilter(const luabridge::LuaRef& filter) {
+	SpatialFilter spatial_filter;
+
+	if (filter.isString())
+		spatial_filter.name = filter.cast<Atom>();
+	else if (!filter.isNil())
+		spatial_filter.tag_mask = TagDB::MaskFromLua(filter);
+
+	return spatial_filter;
+}
+
+static luabridge::LuaRef MakeActorTable(const std::vector<SpatialEntry>& entries) {
+	lua_State* lua_state = ComponentManager::GetLuaState();
+
+	lua_createtable(lua_state, static_cast<int>(entries.size()), 0);
+	for (size_t i = 0; i < entries.size(); i++) {
+		luabridge::Stack<Actor*>::push(lua_state, entries[i].actor);
+		lua_rawseti(lua_state, -2, static_cast<int>(i + 1));
+	}
+
+	return luabridge::LuaRef::fromStack(lua_state);
+}
+
+luabridge::LuaRef Scene::FindInRadius(float x, float y, float radius, luabridge::LuaRef name) {
+	spatial_hash.Refresh(this);
+
+	std::vector<SpatialEntry> results;
+	spatial_hash.QueryRadius(x, y, radius, ReadSpatialFilter(name), results);
+	return MakeActorTable(results);
+}
+
+luabridge::LuaRef Scene::FindInRect(float min_x, float min_y, float max_x, float max_y, luabridge::LuaRef name) {
+	spatial_hash.Refresh(this);
+
+	std::vector<SpatialEntry> results;
+	spatial_hash.QueryRect(std::min(min_x, max_x), std::min(min_y, max_y), std::max(min_x, max_x), std::max(min_y, max_y), ReadSpatialFilter(name), results);
+	return MakeActorTable(results);
+}
+
+luabridge::LuaRef Scene::FindNearest(float x, float y, luabridge::LuaRef name, luabridge::LuaRef max_radius) {
+	spatial_hash.Refresh(this);
+
+	float radius = max_radius.isNumber() ? max_radius.cast<float>() : -1.0f;
+	Actor* nearest = spatial_hash.QueryNearest(x, y, radius, ReadSpatialFilter(name));
+	return luabridge::LuaRef(ComponentManager::GetLuaState(), nearest);
+}
+
+luabridge::LuaRef Scene::FindByTag(Atom tag) {
+	return FindByMask(TagDB::FindMask(tag), false);
+}
+
+luabridge::LuaRef Scene::FindByMask(uint64_t mask, bool match_all) {
+	lua_State* lua_state = ComponentManager::GetLuaState();
+	lua_newtable(lua_state);
+	if (mask == 0)
+		return luabridge::LuaRef::fromStack(lua_state);
+
+	auto matches = [mask, match_all](Actor* actor) {
+		if (actor->destroyed)
+			return false;
+		return match_all ? (actor->tag_mask & mask) == mask : (actor->tag_mask & mask) != 0;
+	};
+
+	int index = 1;
+	auto push = [lua_state, &index](Actor* actor) {
+		luabridge::Stack<Actor*>::push(lua_state, actor);
+		lua_rawseti(lua_state, -2, index++);
+	};
+
+	if (match_all || (mask & (mask - 1)) == 0) {
+		// Every match is in the shortest list of the mask's tags
+		std::vector<Actor*>* shortest = nullptr;
+		for (uint64_t bits = mask; bits != 0; bits &= bits - 1) {
+			std::vector<Actor*>& tag_list = tagged_actors[TagDB::LowestBit(bits)];
+			if (shortest == nullptr || tag_list.size() < shortest->size())
+				shortest = &tag_list;
+		}
+
+		for (Actor* actor : *shortest) {
+			if (matches(actor))
+				push(actor);
+		}
+	}
+	else {
+		// An actor can be in several of the lists, take each one once in scene order
+		for (Actor* actor : actors) {
+			if (matches(actor))
+				push(actor);
+		}
+	}
+
+	// Not started yet, so not in the tag lists
+	for (Actor* actor : actors_to_add) {
+		if (matches(actor))
+			push(actor);
+	}
+
+	return luabridge::LuaRef::fromStack(lua_state);
+}
+
+luabridge::LuaRef Scene::FindAll(Atom name) {
 	luabridge::LuaRef ref = luabridge::newTable(ComponentManager::GetLuaState());
 	bool foundSomething = false;
 	int index = 1; // Lua tables are 1-based
 
-	if (findActors.find(name) != findActors.end()) {
-		if (findActors[name].size() != 0) {
-			for (Actor* actor : findActors[name]) {
-				if (!actor->destroyed) {
-					ref[index] = actor; // Insert using numeric index
-					foundSomething = true;
-					index++;
-				}
+	auto actors_with_name = findActors.find(name);
+	if (actors_with_name != findActors.end()) {
+		for (Actor* actor : actors_with_name->second) {
+			if (!actor->destroyed) {
+				ref[index] = actor; // Insert using numeric index
+				foundSomething = true;
+				index++;
 			}
 		}
 	}
@@ -175,45 +618,87 @@ luabridge::LuaRef Scene::FindAll(const std::string & name) {
 	return luabridge::LuaRef(ComponentManager::GetLuaState()); // returns nil to lua if none found
 }
 
-luabridge::LuaRef Scene::Instantiate(const std::string& actor_template_name) {
+Actor* Scene::CreateFromTemplate(Actor* actor_template) {
+	if (actor_template->pool != nullptr && !actor_template->pool->inactive.empty()) {
+		Actor* actor = actor_template->pool->inactive.back();
+		actor_template->pool->inactive.pop_back();
+		actor->Reuse(GameData::GetUUID());
+		return actor;
+	}
 
 	// Use template copy constructor to make new actor
-	Actor* newActor = new Actor(TemplateDB::GetTemplate(actor_template_name), GameData::GetUUID());
+	return ActorHandle::pool.Create(actor_template, GameData::GetUUID());
+}
+
+luabridge::LuaRef Scene::Instantiate(const std::string& actor_template_name) {
+
+	Actor* newActor = CreateFromTemplate(TemplateDB::GetTemplate(actor_template_name));
 
 	actors_to_add.emplace_back(newActor);
-	findActors[newActor->name].emplace_back(newActor);
+	findActors[newActor->name_id].emplace_back(newActor);
 
 	return luabridge::LuaRef(ComponentManager::GetLuaState(), newActor);
 }
 
-void Scene::Destroy(Actor* actor) {
-	if (actor->destroyed) return;
+luabridge::LuaRef Scene::InstantiateMany(const std::string& actor_template_name, int count, luabridge::LuaRef initializer) {
+	lua_State* lua_state = ComponentManager::GetLuaState();
+	if (count < 0) count = 0;
 
-	actor->Destroy();
+	Actor* actor_template = TemplateDB::GetTemplate(actor_template_name);
 
-	// TODO: OPT There may be a way to speed this up instead of having to loop through
-	// all actors for every destroy call
-	for (int i = 0; i < actors.size(); i++) {
-		if (actor->GetID() == actors[i]->GetID()) {
-			actors_to_destroy.emplace_back(i);
-			RemoveFromFindActors(actor);
-			return;
-		}
+	actors_to_add.reserve(actors_to_add.size() + count);
+	std::vector<Actor*>& actors_with_name = findActors[actor_template->name_id];
+	actors_with_name.reserve(actors_with_name.size() + count);
+
+	// Every copied component is indexed by its lua identity, size the index once for the whole batch
+	size_t component_count = static_cast<size_t>(count) * actor_template->components.size();
+	ComponentManager::components_by_ref.reserve(ComponentManager::components_by_ref.size() + component_count);
+	NativeComponentRegistry::components_by_instance.reserve(NativeComponentRegistry::components_by_instance.size() + component_count);
+
+	lua_createtable(lua_state, count, 0);
+	for (int i = 0; i < count; i++) {
+		Actor* newActor = CreateFromTemplate(actor_template);
+		actors_to_add.emplace_back(newActor);
+		actors_with_name.emplace_back(newActor);
+
+		luabridge::Stack<Actor*>::push(lua_state, newActor);
+		lua_rawseti(lua_state, -2, i + 1);
 	}
+	luabridge::LuaRef spawned = luabridge::LuaRef::fromStack(lua_state);
 
-	// If actor was not in actors, it must have been added this frame.
-	// Thus, we can just remove it directly from the actors to add array safely.
-	if (!actors_to_add.empty()) {
-		for (int i = 0; i < actors_to_add.size(); i++) {
-			if (actor->GetID() == actors_to_add[i]->GetID()) {
-				actor->OnDestroy();
-				actors_to_add.erase(actors_to_add.begin() + i);
-				RemoveFromFindActors(actor);
-				delete actor;
-				return;
+	if (initializer.isFunction()) {
+		for (int i = 1; i <= count; i++) {
+			try {
+				initializer(spawned[i], i);
+			}
+			catch (const luabridge::LuaException& e) {
+				EngineUtils::ReportError(actor_template->name, e);
 			}
 		}
 	}
+
+	return spawned;
+}
+
+void Scene::Destroy(Actor* actor) {
+	// nullptr if a script passed a handle to an actor that is already gone
+	if (actor == nullptr || actor->destroyed) return;
+
+	actor->Destroy();
+
+	// Find() skips destroyed actors, so the name index can be cleaned up once per frame
+	names_to_compact.emplace_back(actor->name_id);
+
+	if (actor->scene_index != -1) {
+		destroyed_mask[actor->scene_index] = 1;
+		destroyed_count++;
+		return;
+	}
+
+	// If actor was not in actors, it must have been added this frame. It never
+	// started, so it is torn down now and skipped when actors_to_add is processed.
+	actor->OnDestroy();
+	destroyed_pending_count++;
 }
 
 void Scene::ProcessDontDestroyOnLoad(Scene* oldScene) {
@@ -229,14 +714,27 @@ void Scene::ProcessDontDestroyOnLoad(Scene* oldScene) {
 
 		DontDestroyOnLoad(actor);
 		DDOLActors.emplace_back(actor);
-		findActors[actor->name].insert(findActors[actor->name].begin(), actor);
+		std::vector<Actor*>& actors_with_name = findActors[actor->name_id];
+		actors_with_name.insert(actors_with_name.begin(), actor);
 	}
 
 	// Insert DDOL Actors at beginning so they come up first in Find()
 	actors.insert(actors.begin(), DDOLActors.begin(), DDOLActors.end());
+	destroyed_mask.assign(actors.size(), 0);
+
+	for (size_t i = 0; i < actors.size(); i++) {
+		actors[i]->scene = this;
+		actors[i]->scene_index = static_cast<int>(i);
+	}
+
+	// Every index moved, rebuilding is simpler than patching (scene loads are rare)
+	RebuildDispatch();
+	RebuildTagLists();
 }
 
 void Scene::DontDestroyOnLoad(Actor* actor) {
+	if (actor == nullptr) return;
+
 	actor->dontDestroyOnLoad = true;
 
 	// Only add to structures if the actor isn't already in them
@@ -246,13 +744,24 @@ void Scene::DontDestroyOnLoad(Actor* actor) {
 	}
 }
 
-void Scene::RemoveFromFindActors(Actor* actor) {
-	// Remove the actor from the accelerating structure
-	if (findActors.find(actor->name) != findActors.end()) {
-		if (findActors[actor->name].size() != 0) {
-			findActors[actor->name].erase(
-				std::remove(findActors[actor->name].begin(),
-					findActors[actor->name].end(), actor), findActors[actor->name].end());
-		}
+void Scene::CompactFindActors() {
+	if (names_to_compact.empty())
+		return;
+
+	// One stable pass per name no matter how many of its actors were destroyed
+	std::sort(names_to_compact.begin(), names_to_compact.end(),
+		[](const Atom& a, const Atom& b) { return a.id < b.id; });
+	names_to_compact.erase(std::unique(names_to_compact.begin(), names_to_compact.end()), names_to_compact.end());
+
+	for (const Atom& name : names_to_compact) {
+		auto actors_with_name = findActors.find(name);
+		if (actors_with_name == findActors.end())
+			continue;
+
+		std::vector<Actor*>& actor_list = actors_with_name->second;
+		actor_list.erase(std::remove_if(actor_list.begin(), actor_list.end(),
+			[](Actor* actor) { return actor->destroyed; }), actor_list.end());
 	}
+
+	names_to_compact.clear();
 }
@@ -5,12 +5,16 @@
 #include "gameData.h"
 #include "TemplateDB.h"
 #include "actor.h"
+#include "SpatialHash.h"
+#include "TagDB.h"
 #include <string>
 #include <iostream>
 #include <algorithm> // For std::sort
 #include <unordered_map>
 #include <limits>
 #include <unordered_set>
+#include <deque>
+#include <memory>
 
 /*struct Space
 {
@@ -88,6 +92,32 @@ public:
 
 };*/
 
+// An (actor, component) pair in one of the scene's per-phase dispatch lists
+class DispatchEntry {
+public:
+	Actor* actor;
+	// nullptr once the component is removed, until the list is compacted
+	Component* component;
+};
+
+// A cell of a chunked scene and the actors declared in it. Chunks near the camera are
+// instantiated a few actors per frame, and switched off again once the camera moves away.
+class SceneChunk {
+public:
+	int x = 0;
+	int y = 0;
+
+	// Points into Scene::chunk_document
+	const rapidjson::Value* actors = nullptr;
+
+	// Next entry of actors to instantiate, the chunk is fully loaded once it reaches the end
+	rapidjson::SizeType next_actor = 0;
+	bool queued = false;
+	bool active = false;
+
+	std::vector<ActorHandle> spawned;
+};
+
 class Scene
 {
 public:
@@ -95,10 +125,32 @@ public:
 
 	std::vector<Actor*> actors;
 	std::vector<Actor*> actors_to_add;
-	std::unordered_map<std::string, std::vector<Actor*>> findActors;
+	std::unordered_map<Atom, std::vector<Actor*>> findActors;
 
-	// Actors to destroy, by their index in actors array
-	std::vector<int> actors_to_destroy;
+	// Parallel to actors, 1 where the actor was destroyed this frame. They are all
+	// removed together in one stable pass at the end of UpdateActors.
+	std::vector<uint8_t> destroyed_mask;
+	int destroyed_count = 0;
+
+	// Actors added this frame that were destroyed before they started
+	int destroyed_pending_count = 0;
+
+	// Names whose findActors lists hold destroyed actors
+	std::vector<Atom> names_to_compact;
+
+	// Every component with an OnUpdate/OnLateUpdate in the scene, ordered by the actor's
+	// position in actors and then by component key, so execution order matches walking
+	// each actor's components. Actors without either function never appear here.
+	std::vector<DispatchEntry> update_dispatch;
+	std::vector<DispatchEntry> late_update_dispatch;
+	int removed_dispatch_count = 0;
+
+	// Actors with runtime added/removed components waiting to be processed
+	std::vector<ActorHandle> actors_with_added_components;
+	std::vector<ActorHandle> actors_with_removed_components;
+
+	// Actors reactivated with SetActive, put back in the dispatch lists at the start of the next update
+	std::vector<ActorHandle> actors_to_activate;
 
 	std::vector<Actor*> dont_destroy_on_load_actors;
 	std::unordered_set<Actor*> DDOL_actors_in_scene;
@@ -115,11 +167,28 @@ public:
 	// rendering a bunch of actors that don't show up
 	std::vector<Actor*> actorsToRender;
 
+	// Backs FindInRadius/FindInRect/FindNearest
+	SpatialHash spatial_hash;
+
+	// Started actors with each tag bit, see TagDB
+	std::vector<Actor*> tagged_actors[TagDB::MAX_TAGS];
+
+	// Set for scenes with "chunks", the parsed file the chunks' actors are read from
+	std::shared_ptr<rapidjson::Document> chunk_document;
+	std::vector<SceneChunk> chunks;
+	// World units per chunk, "chunk_size" in the scene file
+	float chunk_size = 32.0f;
+	// Chunk the camera was in last frame
+	int camera_chunk_x = std::numeric_limits<int>::min();
+	int camera_chunk_y = std::numeric_limits<int>::min();
+	// Indices into chunks still being instantiated, nearest to the camera first
+	std::deque<int> chunks_to_load;
+
 
 	// Constructor from JSON file
 	Scene(rapidjson::Document& sceneDoc, std::string sceneName);
 
-	// Constructor from cached scene object
+	// Constructor from a scene snapshot, copies its actors without going back to JSON
 	Scene(const Scene& other, std::string sceneName);
 
 	~Scene() {
@@ -127,7 +196,7 @@ public:
 			if (!actor->dontDestroyOnLoad) {
 				actor->Destroy();
 				actor->OnDestroy();
-				delete actor;
+				ActorHandle::pool.Release(actor);
 			}
 		}
 	}
@@ -136,9 +205,22 @@ public:
 
 	std::string GetSceneName();
 
-	luabridge::LuaRef Find(const std::string& name);
+	luabridge::LuaRef Find(Atom name);
+
+	luabridge::LuaRef FindAll(Atom name);
 
-	luabridge::LuaRef FindAll(const std::string& name);
+	luabridge::LuaRef FindByTag(Atom tag);
+
+	// Actors with any of the mask's tags, or all of them if match_all
+	luabridge::LuaRef FindByMask(uint64_t mask, bool match_all);
+
+	// Spatial queries, name is an optional actor name filter (nil for any actor).
+	// Positions are those of each actor's Rigidbody when the frame's first query ran.
+	luabridge::LuaRef FindInRadius(float x, float y, float radius, luabridge::LuaRef name);
+
+	luabridge::LuaRef FindInRect(float min_x, float min_y, float max_x, float max_y, luabridge::LuaRef name);
+
+	luabridge::LuaRef FindNearest(float x, float y, luabridge::LuaRef name, luabridge::LuaRef max_radius);
 
 	//Updates all actors with an OnUpdate function
 	void UpdateActors();
@@ -146,13 +228,51 @@ public:
 	//Updates all actors with an OnLateUpdate function
 	void LateUpdate();
 
+	// A new actor from the template, or an inactive one from its pool if it is pooled
+	Actor* CreateFromTemplate(Actor* actor_template);
+
+	// Creates an actor from its scene file entry and queues it to be added
+	Actor* CreateFromJson(const rapidjson::Value& actor);
+
+	// Activates chunks within GameData::STREAM_RADIUS chunks of the camera and deactivates ones
+	// that are more than a chunk further out, then instantiates queued chunk actors until
+	// GameData::STREAM_BUDGET_MS runs out. Call at the start of every frame.
+	void UpdateStreaming(float camera_x, float camera_y);
+
+	void RefreshChunks();
+
+	void LoadQueuedChunks();
+
 	luabridge::LuaRef Instantiate(const std::string& actor_template_name);
 
+	// Instantiates count copies of the template with one template lookup and returns them
+	// in a single table. initializer(actor, i), if given, runs on each before its OnStart.
+	luabridge::LuaRef InstantiateMany(const std::string& actor_template_name, int count, luabridge::LuaRef initializer);
+
 	void Destroy(Actor* actor);
 
 	void DontDestroyOnLoad(Actor* actor);
 
-	void RemoveFromFindActors(Actor* actor);
+	// Remove every destroyed actor from the findActors lists of names_to_compact
+	void CompactFindActors();
+
+	// Stable pass over actors, dropping and freeing the destroyed ones
+	void CompactDestroyedActors();
+
+	void AppendActor(Actor* actor);
+
+	void UpdateTagLists(Actor* actor, uint64_t old_mask, uint64_t new_mask);
+
+	void RebuildTagLists();
+
+	void AddToDispatch(Actor* actor, Component* component);
+
+	void RemoveFromDispatch(Actor* actor, Component* component);
+
+	// Drop removed components and destroyed actors from the dispatch lists, before actors are re-indexed
+	void CompactDispatch();
+
+	void RebuildDispatch();
 
 	//std::vector<Actor*> GetSortedActorVector(std::vector<Actor*> actors);
 
@@ -1,20 +1,15 @@
 #include "utility.h"
+#include "ErrorLog.h"
+#include "ComponentManager.h"
 
 void EngineUtils::ReportError(const std::string& actor_name, const luabridge::LuaException& e) {
-	std::string error_message = e.what();
-
-	// Normalize file paths across platforms
-	std::replace(error_message.begin(), error_message.end(), '\\', '/');
-
-	// Find the "resources/" folder and strip everything before it
-	std::string target = "resources/";
-	size_t pos = error_message.find(target);
-	if (pos != std::string::npos) {
-		error_message = error_message.substr(pos); // Keep everything from "resources/" onwards
-	}
+	// Formatting and output happen on the log thread
+	ErrorLog::Report(actor_name, "", e.what());
+}
 
-	// Display (with color codes)
-	std::cout << "\033[31m" << actor_name << " : " << error_message << "\033[0m\n";
+void EngineUtils::ReportError(const std::string& actor_name, Component* component, const luabridge::LuaException& e) {
+	ErrorLog::Report(actor_name, component->type, e.what());
+	ErrorLog::RecordComponentFailure(actor_name, component);
 }
 
 /*
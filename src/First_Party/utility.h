@@ -11,6 +11,17 @@
 #include "LuaBridge/LuaBridge.h"
 #include "box2d/box2d.h"
 
+// Engine state (scenes, actors, the Lua state, the Box2D world, ...) lives in static members.
+// Building with ENGINE_MULTI_INSTANCE makes it thread_local, so every thread that calls
+// Game::Init runs its own independent game and several headless ones can share a process.
+#ifdef ENGINE_MULTI_INSTANCE
+#define ENGINE_THREAD_LOCAL thread_local
+#else
+#define ENGINE_THREAD_LOCAL
+#endif
+
+class Component;
+
 class TextRenderRequest {
 public:
 	std::string text;
@@ -165,6 +176,10 @@ public:
 	}
 
 	static void ReportError(const std::string& actor_name, const luabridge::LuaException& e);
+
+	// Reports the error and counts it against the component, which is disabled
+	// if it keeps failing every frame (see ErrorLog::disable_after_frames)
+	static void ReportError(const std::string& actor_name, Component* component, const luabridge::LuaException& e);
 };
 
 #endif
\ No newline at end of file
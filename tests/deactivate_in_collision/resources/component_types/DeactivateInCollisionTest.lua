@@ -0,0 +1,50 @@
+-- The faller hits the ground and deactivates itself in OnCollisionEnter. Its body must be switched
+-- off once the step is over and stay where it was, then fall again once the actor is reactivated.
+DeactivateInCollisionTest = {
+	OnStart = function(self)
+		self.faller = Actor.Find("Faller")
+		self.body = self.faller:GetComponent("Rigidbody")
+		self.listener = self.faller:GetComponent("DeactivateOnCollision")
+		self.frame = 0
+	end,
+
+	OnUpdate = function(self)
+		self.frame = self.frame + 1
+
+		if self.stopped_at == nil then
+			if self.listener.collisions ~= nil then
+				self.stopped_at = self.body:GetPosition().y
+				self.stopped_frame = self.frame
+			elseif self.frame > 300 then
+				self:Finish("the faller never collided")
+			end
+			return
+		end
+
+		if self.frame == self.stopped_frame + 30 then
+			if self.faller:IsActive() then
+				return self:Finish("the faller is still active")
+			end
+			if self.body:GetPosition().y ~= self.stopped_at then
+				return self:Finish("the disabled body kept moving")
+			end
+			self.body:SetPosition(Vector2(0, -5))
+			self.body:SetVelocity(Vector2(0, 0))
+			self.faller:SetActive(true)
+		elseif self.frame == self.stopped_frame + 60 then
+			if self.body:GetPosition().y <= -5 then
+				return self:Finish("the reactivated body didn't fall")
+			end
+			self:Finish(nil)
+		end
+	end,
+
+	Finish = function(self, failure)
+		if failure == nil then
+			print("PASS deactivate_in_collision")
+		else
+			print("FAIL deactivate_in_collision: " .. failure)
+		end
+		Application.Quit()
+	end
+}
@@ -0,0 +1,7 @@
+-- Deactivates its actor from inside the physics step
+DeactivateOnCollision = {
+	OnCollisionEnter = function(self, collision)
+		self.collisions = (self.collisions or 0) + 1
+		self.actor:SetActive(false)
+	end
+}
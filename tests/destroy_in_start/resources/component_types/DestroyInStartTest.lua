@@ -0,0 +1,39 @@
+-- A Destroyer and a Victim are spawned in the same frame and the Destroyer's OnStart destroys the
+-- Victim. Its freed slot is reused by the next Instantiate, which must not be found as the Victim.
+DestroyInStartTest = {
+	OnStart = function(self)
+		self.frame = 0
+	end,
+
+	OnUpdate = function(self)
+		self.frame = self.frame + 1
+
+		if self.frame == 1 then
+			Actor.Instantiate("Destroyer")
+			Actor.Instantiate("Victim")
+		elseif self.frame == 3 then
+			Actor.Instantiate("Bystander")
+		elseif self.frame == 5 then
+			local found = Actor.Find("Victim")
+			if found ~= nil then
+				return self:Finish("Find(\"Victim\") returned " .. found:GetName())
+			end
+			if Actor.FindAll("Victim") ~= nil then
+				return self:Finish("FindAll(\"Victim\") found an actor")
+			end
+			if Actor.Find("Bystander") == nil then
+				return self:Finish("the Bystander can't be found")
+			end
+			self:Finish(nil)
+		end
+	end,
+
+	Finish = function(self, failure)
+		if failure == nil then
+			print("PASS destroy_in_start")
+		else
+			print("FAIL destroy_in_start: " .. failure)
+		end
+		Application.Quit()
+	end
+}
@@ -0,0 +1,6 @@
+-- Destroys the Victim spawned in the same frame, before it has started
+DestroyVictimOnStart = {
+	OnStart = function(self)
+		Actor.Destroy(Actor.Find("Victim"))
+	end
+}
@@ -0,0 +1,12 @@
+-- Subscribes every time its actor starts, including when it is reused from the pool
+pings_received = 0
+
+PingListener = {
+	OnStart = function(self)
+		Event.Subscribe("Ping", self, self.OnPing)
+	end,
+
+	OnPing = function(self)
+		pings_received = pings_received + 1
+	end
+}
@@ -0,0 +1,46 @@
+-- Spawns a pooled Listener, pings it and destroys it, several times over. The subscriptions left
+-- behind by the pooled actor must be cleaned up rather than pile up with every round trip.
+PooledSubscriptionsTest = {
+	rounds = 5,
+
+	OnStart = function(self)
+		self.frame = 0
+		self.round = 0
+	end,
+
+	OnUpdate = function(self)
+		self.frame = self.frame + 1
+		local step = self.frame % 4
+
+		if self.round < self.rounds then
+			if step == 1 then
+				self.listener = Actor.Instantiate("Listener")
+			elseif step == 3 then
+				Event.Publish("Ping")
+				Actor.Destroy(self.listener)
+				self.round = self.round + 1
+			end
+		elseif self.last_ping == nil then
+			Event.Publish("Ping")
+			self.last_ping = self.frame
+		elseif self.frame == self.last_ping + 2 then
+			if pings_received ~= self.rounds then
+				return self:Finish("expected " .. self.rounds .. " pings, got " .. pings_received)
+			end
+			local count = Event.SubscriberCount("Ping")
+			if count ~= 0 then
+				return self:Finish(count .. " subscriptions left after every listener was destroyed")
+			end
+			self:Finish(nil)
+		end
+	end,
+
+	Finish = function(self, failure)
+		if failure == nil then
+			print("PASS pooled_subscriptions")
+		else
+			print("FAIL pooled_subscriptions: " .. failure)
+		end
+		Application.Quit()
+	end
+}
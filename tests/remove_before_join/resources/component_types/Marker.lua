@@ -0,0 +1,8 @@
+-- Counts how many Markers have actually been removed
+destroyed_markers = 0
+
+Marker = {
+	OnDestroy = function(self)
+		destroyed_markers = destroyed_markers + 1
+	end
+}
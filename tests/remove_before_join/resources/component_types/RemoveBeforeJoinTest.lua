@@ -0,0 +1,35 @@
+-- Removes a component right after Instantiate, before the actor has joined the scene. The removal
+-- must still happen, and a later RemoveComponent on the same actor must not be dropped.
+RemoveBeforeJoinTest = {
+	OnStart = function(self)
+		self.frame = 0
+	end,
+
+	OnUpdate = function(self)
+		self.frame = self.frame + 1
+
+		if self.frame == 1 then
+			self.target = Actor.Instantiate("Target")
+			self.target:RemoveComponent(self.target:GetComponentByKey("1"))
+		elseif self.frame == 3 then
+			if destroyed_markers ~= 1 then
+				return self:Finish("the component removed before the first frame was never removed")
+			end
+			self.target:RemoveComponent(self.target:GetComponentByKey("2"))
+		elseif self.frame == 5 then
+			if destroyed_markers ~= 2 then
+				return self:Finish("the second RemoveComponent was dropped")
+			end
+			self:Finish(nil)
+		end
+	end,
+
+	Finish = function(self, failure)
+		if failure == nil then
+			print("PASS remove_before_join")
+		else
+			print("FAIL remove_before_join: " .. failure)
+		end
+		Application.Quit()
+	end
+}
@@ -0,0 +1,40 @@
+-- Assigning a value of the wrong type to a schema field must raise an error and keep the old value,
+-- not quietly store 0
+SchemaFieldTypesTest = {
+	OnStart = function(self)
+		local stats = self.actor:GetComponent("Stats")
+
+		local bad = {
+			{ "speed", nil }, { "speed", "fast" }, { "speed", {} },
+			{ "lives", "three" }, { "alive", 1 }, { "title", {} }
+		}
+		for _, case in ipairs(bad) do
+			local old = stats[case[1]]
+			if pcall(function() stats[case[1]] = case[2] end) then
+				return self:Finish("assigning a " .. type(case[2]) .. " to " .. case[1] .. " didn't raise an error")
+			end
+			if stats[case[1]] ~= old then
+				return self:Finish(case[1] .. " changed to " .. tostring(stats[case[1]]))
+			end
+		end
+
+		stats.speed = 4
+		stats.lives = "5"
+		stats.alive = false
+		stats.title = 7
+		if stats.speed ~= 4 or stats.lives ~= 5 or stats.alive ~= false or stats.title ~= "7" then
+			return self:Finish("a valid assignment was rejected")
+		end
+
+		self:Finish(nil)
+	end,
+
+	Finish = function(self, failure)
+		if failure == nil then
+			print("PASS schema_field_types")
+		else
+			print("FAIL schema_field_types: " .. failure)
+		end
+		Application.Quit()
+	end
+}
@@ -0,0 +1,7 @@
+Stats = {
+	speed = 2.5,
+	lives = 3,
+	alive = true,
+	title = "hero",
+	__schema = { speed = "float", lives = "int", alive = "bool", title = "string" }
+}
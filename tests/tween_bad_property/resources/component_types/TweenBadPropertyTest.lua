@@ -0,0 +1,34 @@
+-- A tween writing a property its native target doesn't have must be reported and stopped, not
+-- take the game down, and the other tweens keep playing.
+TweenBadPropertyTest = {
+	OnStart = function(self)
+		self.frame = 0
+		self.mover = Actor.Find("Mover")
+	end,
+
+	OnUpdate = function(self)
+		self.frame = self.frame + 1
+
+		if self.frame == 10 then
+			if self.mover:GetComponentByKey("bad"):IsPlaying() then
+				return self:Finish("the tween with the bad property is still playing")
+			end
+			if not self.mover:GetComponentByKey("good"):IsPlaying() then
+				return self:Finish("the good tween stopped")
+			end
+			if self.mover:GetComponent("Transform").x <= 0 then
+				return self:Finish("the good tween didn't move the transform")
+			end
+			self:Finish(nil)
+		end
+	end,
+
+	Finish = function(self, failure)
+		if failure == nil then
+			print("PASS tween_bad_property")
+		else
+			print("FAIL tween_bad_property: " .. failure)
+		end
+		Application.Quit()
+	end
+}